@@ -1,932 +1,3722 @@
 #include <WiFi.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
+#include <WebSocketsServer.h>
+#include <WiFiUdp.h>
 #include <Wire.h>
 #include <Adafruit_PWMServoDriver.h>
-#include <ArduinoJson.h>
 #include <ArduinoOTA.h>
 #include <Update.h>
+#include <Preferences.h>
+#include <LittleFS.h>
+#include <mbedtls/sha256.h>
+#include <atomic>
+
+// HTML Dashboard with OTA functionality, gzipped from dashboard.html by
+// gzip_dashboard.py
+#include "dashboard_html_gz.h"
 
 // WiFi Credentials
 const char *ssid = "10xTC-AP2";
 const char *password = "10xTechClub#";
 
-// PCA9685 setup
-#define PCA9685_ADDRESS 0x40
+// PCA9685 setup; boards and joint wiring are listed with the servo bus
 #define SDA_PIN 21
 #define SCL_PIN 22
 #define SERVO_FREQ 50  // Analog servos run at ~50 Hz updates
 
-Adafruit_PWMServoDriver pwm = Adafruit_PWMServoDriver(PCA9685_ADDRESS);
-WebServer server(80);
+AsyncWebServer server(80);
+WebSocketsServer webSocket(81);
+WiFiUDP udp;
+
+// HTTP handlers run in the async TCP task while loop() services UDP, the
+// WebSocket, sequences and telemetry. Both feed the producer end of the
+// motion command ring and share the response buffer, so they take turns
+// under apiLock. Every critical section is a parse and an enqueue.
+#define API_LOCK_WAIT_MS 200
+
+SemaphoreHandle_t apiLock;
+
+struct ApiGuard {
+  bool locked;
+  explicit ApiGuard(TickType_t wait = pdMS_TO_TICKS(API_LOCK_WAIT_MS))
+    : locked(xSemaphoreTake(apiLock, wait) == pdTRUE) {}
+  ~ApiGuard() {
+    if (locked) xSemaphoreGive(apiLock);
+  }
+};
 
 // Servo configuration
 #define NUM_SERVOS 18
-#define SERVO_MIN 150   // Minimum pulse width (out of 4096)
-#define SERVO_MAX 600   // Maximum pulse width (out of 4096)
+#define SERVO_MIN 150   // Default minimum pulse width (out of 4096)
+#define SERVO_MAX 600   // Default maximum pulse width (out of 4096)
+#define POSE_MOVE_MS 800  // Default duration of named pose transitions
+
+
+void gaitTick();
+
 
+// Joint angles are carried as centi-degrees (0-18000) in uint16_t from the
+// request handlers through the motion tick down to the PWM conversion, so
+// slow moves use every tick the PCA9685 offers. The REST API keeps whole
+// degrees and converts at the edge.
+#define CDEG(deg) ((deg) * 100)
+#define CDEG_MAX CDEG(180)
 
-void standUp();
-void sitDown();
+// Current servo positions (cdeg) as sent to the PWM, owned by the motion
+// tick. The planners write poseCommand; the output limiter moves
+// servoPositions toward it.
+uint16_t servoPositions[NUM_SERVOS];
+uint16_t poseCommand[NUM_SERVOS];
+bool posePending = false;  // servoPositions changed since the last publish
+
+// Seqlock-published copy of servoPositions for readers on other tasks. The
+// writer bumps seq to odd, stores the joints two per word, then bumps it to
+// even;
+// readers retry until they see the same even seq on both sides of the copy.
+// Joints are stored as relaxed atomic words, so a reader never blocks the
+// tick and never returns a half-written frame.
+#define POSE_WORDS ((NUM_SERVOS + 1) / 2)
+
+struct alignas(32) PoseSnapshot {   // starts on an ESP32 cache line
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> words[POSE_WORDS];
+};
+
+PoseSnapshot publishedPose;
+
+// Writer side: only the motion tick calls this
+void posePublish() {
+  uint32_t packed[POSE_WORDS] = {};
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    packed[i / 2] |= (uint32_t)servoPositions[i] << (16 * (i % 2));
+  }
+
+  uint32_t seq = publishedPose.seq.load(std::memory_order_relaxed);
+  publishedPose.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (int w = 0; w < POSE_WORDS; w++) {
+    publishedPose.words[w].store(packed[w], std::memory_order_relaxed);
+  }
+  publishedPose.seq.store(seq + 2, std::memory_order_release);
+  posePending = false;
+}
 
+// Reader side: copy the latest whole frame
+void poseSnapshot(uint16_t out[NUM_SERVOS]) {
+  uint32_t packed[POSE_WORDS];
+  uint32_t before, after;
+  do {
+    before = publishedPose.seq.load(std::memory_order_acquire);
+    for (int w = 0; w < POSE_WORDS; w++) {
+      packed[w] = publishedPose.words[w].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = publishedPose.seq.load(std::memory_order_relaxed);
+  } while ((before & 1) || before != after);
 
-// Current servo positions (in degrees 0-180)
-int servoPositions[NUM_SERVOS];
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    out[i] = packed[i / 2] >> (16 * (i % 2));
+  }
+}
 
 // OTA Update variables
 bool otaInProgress = false;
 String otaStatus = "Ready";
 
-// Convert angle to PWM value
-uint16_t angleToPWM(int angle) {
-  return map(constrain(angle, 0, 180), 0, 180, SERVO_MIN, SERVO_MAX);
+// Browser uploads are hashed as they stream, so a corrupt image is rejected
+// before the boot partition is switched
+mbedtls_sha256_context otaSha;
+bool otaUploadOk = false;        // no step of the current upload has failed
+char otaExpectedSha[65];         // hex digest supplied by the client, or empty
+uint32_t otaStartMs = 0;
+bool otaRestartPending = false;  // reboot from loop() once the reply is out
+uint32_t otaRestartAtMs = 0;
+
+// Hot-path instrumentation. Set ENABLE_METRICS to 0 to compile every probe
+// and the /metrics endpoint out of the firmware.
+#ifndef ENABLE_METRICS
+#define ENABLE_METRICS 1
+#endif
+
+#if ENABLE_METRICS
+enum MetricId : uint8_t {
+  METRIC_LOOP,
+  METRIC_MOTION_TICK,
+  METRIC_I2C_COMMIT,
+  METRIC_SET_SERVO,
+  METRIC_SET_ALL,
+  METRIC_SWEEP,
+  METRIC_UPDATE,
+  METRIC_COUNT
+};
+
+const char *const metricNames[METRIC_COUNT] = {
+  "loop", "motion_tick", "i2c_commit", "set_servo", "set_all", "sweep", "update"
+};
+
+// Log-linear histogram: four buckets per power of two of microseconds,
+// enough to span 0 us to ~30 s in fixed memory
+#define HIST_BUCKETS 96
+
+struct LatencyHist {
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint32_t buckets[HIST_BUCKETS];
+};
+
+LatencyHist metrics[METRIC_COUNT];
+
+// Clock source in microseconds; override for a simulated clock. micros()
+// reads esp_timer, which both cores share. The CPU cycle counter is per
+// core, and the async TCP task that runs the handlers is not pinned to one.
+#ifndef METRICS_MICROS
+#define METRICS_MICROS() micros()
+#endif
+
+int histBucket(uint32_t us) {
+  if (us < 4) return us;
+  int msb = 31 - __builtin_clz(us);
+  int idx = (msb - 1) * 4 + ((us >> (msb - 2)) & 3);
+  return idx < HIST_BUCKETS ? idx : HIST_BUCKETS - 1;
+}
+
+// Largest value that falls into a bucket
+uint32_t histBucketLimit(int idx) {
+  if (idx < 4) return idx;
+  int msb = idx / 4 + 1;
+  return ((uint32_t)(4 | (idx & 3)) << (msb - 2)) + (1UL << (msb - 2)) - 1;
+}
+
+void metricRecord(MetricId id, uint32_t us) {
+  LatencyHist &h = metrics[id];
+  if (h.count == 0 || us < h.minUs) h.minUs = us;
+  if (us > h.maxUs) h.maxUs = us;
+  h.count++;
+  h.sumUs += us;
+  h.buckets[histBucket(us)]++;
+}
+
+// Upper bound of the bucket holding the given quantile (per mille)
+uint32_t histQuantile(const LatencyHist &h, uint32_t perMille) {
+  uint64_t rank = ((uint64_t)h.count * perMille + 999) / 1000;
+  uint64_t seen = 0;
+  for (int i = 0; i < HIST_BUCKETS; i++) {
+    seen += h.buckets[i];
+    if (seen >= rank && seen > 0) {
+      uint32_t limit = histBucketLimit(i);
+      return limit < h.maxUs ? limit : h.maxUs;
+    }
+  }
+  return h.maxUs;
+}
+
+// Times the enclosing scope
+struct MetricScope {
+  MetricId id;
+  uint32_t start;
+  MetricScope(MetricId metric) : id(metric), start(METRICS_MICROS()) {}
+  ~MetricScope() { metricRecord(id, METRICS_MICROS() - start); }
+};
+
+#define METRIC_SCOPE(id) MetricScope metricScope_(id)
+#else
+#define METRIC_SCOPE(id)
+#endif
+
+// Per-servo calibration. Each channel has its own end points, a trim in
+// centi-degrees and an inversion flag. They are compiled into a 181-entry
+// tick table per servo, so converting an angle is a lookup plus a linear
+// step between neighbouring whole degrees.
+#define CAL_VERSION 1
+
+struct ServoCal {
+  uint16_t minTicks;   // pulse at 0 degrees
+  uint16_t maxTicks;   // pulse at 180 degrees
+  int16_t trim;        // cdeg added to the commanded angle
+  uint8_t invert;      // 1 = servo turns the other way
+  uint8_t reserved;
+};
+
+ServoCal servoCal[NUM_SERVOS];     // live table, owned by the motion tick
+ServoCal calConfig[NUM_SERVOS];    // handler-side copy, edited and saved
+uint16_t angleTicks[NUM_SERVOS][181];
+Preferences prefs;
+
+// Compile one servo's calibration into its tick table
+void calBuild(int servo) {
+  const ServoCal &cal = servoCal[servo];
+  int32_t span = (int32_t)cal.maxTicks - cal.minTicks;
+  for (int angle = 0; angle <= 180; angle++) {
+    int32_t cdeg = (cal.invert ? 180 - angle : angle) * 100 + cal.trim;
+    cdeg = constrain(cdeg, 0, 18000);
+    angleTicks[servo][angle] = cal.minTicks + (span * cdeg + 9000) / 18000;
+  }
+}
+
+void calDefaults() {
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    servoCal[i] = { SERVO_MIN, SERVO_MAX, 0, 0, 0 };
+  }
+}
+
+// Load the table from NVS, falling back to defaults, and build every LUT
+void calLoad() {
+  prefs.begin("hexapod", false);
+  if (prefs.getUShort("calVer", 0) != CAL_VERSION ||
+      prefs.getBytes("cal", servoCal, sizeof(servoCal)) != sizeof(servoCal)) {
+    calDefaults();
+  }
+  memcpy(calConfig, servoCal, sizeof(servoCal));
+  for (int i = 0; i < NUM_SERVOS; i++) calBuild(i);
+}
+
+void calSave(const ServoCal *cal) {
+  prefs.putBytes("cal", cal, sizeof(calConfig));
+  prefs.putUShort("calVer", CAL_VERSION);
+}
+
+// An NVS write can stall for a sector erase, so handlers only mark what
+// changed and loop() writes it once it has let go of apiLock
+#define PERSIST_CAL 0x01
+#define PERSIST_PHASE 0x02
+uint8_t persistDirty = 0;
+uint8_t persistPoseSlots = 0;   // user pose slots to rewrite
+
+// Convert an angle in cdeg to PWM ticks
+uint16_t angleToPWM(int servo, int cdeg) {
+  cdeg = constrain(cdeg, 0, CDEG_MAX);
+  const uint16_t *ticks = angleTicks[servo];
+  int deg = cdeg / 100, frac = cdeg % 100;
+  if (frac == 0) return ticks[deg];
+  // Round half away from zero: an inverted servo's table runs downwards
+  int32_t step = (int32_t)ticks[deg + 1] - ticks[deg];
+  return ticks[deg] + (step * frac + (step < 0 ? -50 : 50)) / 100;
+}
+
+// PCA9685 register layout (each channel has ON_L, ON_H, OFF_L, OFF_H)
+#define PCA9685_MODE1 0x00
+#define MODE1_ALLCAL 0x01          // respond to the all-call address
+#define MODE1_RESTART 0x80
+#define PCA9685_LED0_ON_L 0x06
+#define PCA9685_ALLLED_ON_L 0xFA   // same layout, written to every channel
+#define PCA9685_CHANNELS 16
+#define PCA9685_PERIOD 4096   // counts per PWM period
+#define PCA9685_ALLCALL_ADDRESS 0x70
+
+// Servo bus. Joints map to (board, channel) across the PCA9685s on the one
+// I2C bus; adjust servoMap to the wiring. A commit writes each run of
+// adjacent dirty channels in one burst, and writes that set every output
+// alike go out once to the all-call address, which every board answers.
+#define PCA9685_BOARDS 2
+
+const uint8_t boardAddress[PCA9685_BOARDS] = { 0x40, 0x41 };
+
+struct ServoChannel {
+  uint8_t board;     // index into boardAddress
+  uint8_t channel;
+};
+
+// Joints 0-15 on the first board's channels 0-15, 16-17 on the second's 0-1
+const ServoChannel servoMap[NUM_SERVOS] = {
+  { 0, 0 },  { 0, 1 },  { 0, 2 },  { 0, 3 },  { 0, 4 },  { 0, 5 },
+  { 0, 6 },  { 0, 7 },  { 0, 8 },  { 0, 9 },  { 0, 10 }, { 0, 11 },
+  { 0, 12 }, { 0, 13 }, { 0, 14 }, { 0, 15 }, { 1, 0 },  { 1, 1 },
+};
+
+struct BusStats {
+  uint32_t transactions;
+  uint32_t bytes;      // address + register + data bytes
+  uint32_t errors;     // transactions the board did not acknowledge
+};
+
+int8_t boardJoint[PCA9685_BOARDS][PCA9685_CHANNELS];   // -1 = not wired
+BusStats boardStats[PCA9685_BOARDS];
+BusStats allCallStats;
+
+// Shadow frame: pose changes land here and are flushed by commitFrame()
+uint16_t frameTicks[NUM_SERVOS];
+uint32_t frameDirty = 0;
+
+// Pulse phase. Each channel starts its pulse at its own ON count instead of
+// all at count 0, so the servos draw their drive current one after another
+// across the 20 ms period instead of together. The OFF count is ON plus the
+// pulse width, modulo the period; the PCA9685 ends a pulse whose OFF count
+// is below its ON count in the next period.
+#define PHASE_DEFAULT_STEP (PCA9685_PERIOD / NUM_SERVOS)
+
+uint16_t channelPhase[NUM_SERVOS];   // ON count per channel, owned by the motion tick
+
+// Space the channels' ON counts step counts apart (0 = all at count 0)
+void phaseApply(uint16_t step) {
+  for (int ch = 0; ch < NUM_SERVOS; ch++) {
+    channelPhase[ch] = (uint32_t)ch * step % PCA9685_PERIOD;
+    // Move driven channels over on the next commit
+    if (frameTicks[ch] != 0) frameDirty |= (1UL << ch);
+  }
+}
+
+// I2C traffic counters over all boards (address + register + data bytes)
+uint32_t i2cTransactions = 0;
+uint32_t i2cBytes = 0;
+
+void busCount(BusStats &stats, uint8_t result, uint32_t bytes) {
+  stats.transactions++;
+  stats.bytes += bytes;
+  if (result != 0) stats.errors++;
+  i2cTransactions++;
+  i2cBytes += bytes;
+}
+
+// Bring up every board and index the joint map by (board, channel)
+void busInit() {
+  memset(boardJoint, -1, sizeof(boardJoint));
+  for (int servo = 0; servo < NUM_SERVOS; servo++) {
+    boardJoint[servoMap[servo].board][servoMap[servo].channel] = servo;
+  }
+
+  for (int b = 0; b < PCA9685_BOARDS; b++) {
+    Adafruit_PWMServoDriver board(boardAddress[b]);
+    board.begin();
+    board.setOscillatorFrequency(27000000);
+    board.setPWMFreq(SERVO_FREQ);
+
+    // The driver's reset clears all-call; turn it back on
+    Wire.beginTransmission(boardAddress[b]);
+    Wire.write(PCA9685_MODE1);
+    Wire.endTransmission();
+    Wire.requestFrom(boardAddress[b], (uint8_t)1);
+    uint8_t mode = Wire.read();
+    Wire.beginTransmission(boardAddress[b]);
+    Wire.write(PCA9685_MODE1);
+    Wire.write((mode & ~MODE1_RESTART) | MODE1_ALLCAL);
+    if (Wire.endTransmission() != 0) {
+      Serial.printf("PCA9685 at 0x%02x not responding\n", boardAddress[b]);
+    }
+  }
+}
+
+// Fingerprint of the PWM output stream: FNV-1a over every channel write and
+// the number of commits since the previous write. Replaying a sequence from
+// the same settled pose gives the same digest, so comparing it between
+// firmware builds shows whether the output changed, tick for tick.
+#define PWM_DIGEST_SEED 2166136261UL
+
+uint32_t pwmDigest = PWM_DIGEST_SEED;
+uint32_t pwmDigestFrames = 0;   // commits that wrote something
+uint32_t pwmDigestIdle = 0;     // commits since the last write
+
+void pwmDigestByte(uint8_t b) {
+  pwmDigest = (pwmDigest ^ b) * 16777619UL;
+}
+
+void pwmDigestReset() {
+  pwmDigest = PWM_DIGEST_SEED;
+  pwmDigestFrames = 0;
+  pwmDigestIdle = 0;
+}
+
+void pwmDigestFrame(uint32_t dirty) {
+  if (!dirty) {
+    pwmDigestIdle++;
+    return;
+  }
+  pwmDigestByte(pwmDigestIdle);
+  pwmDigestByte(pwmDigestIdle >> 8);
+  for (int ch = 0; ch < NUM_SERVOS; ch++) {
+    if (!(dirty & (1UL << ch))) continue;
+    pwmDigestByte(ch);
+    pwmDigestByte(frameTicks[ch] & 0xFF);
+    pwmDigestByte(frameTicks[ch] >> 8);
+  }
+  pwmDigestFrames++;
+  pwmDigestIdle = 0;
+}
+
+// Stage a raw tick value for a channel (0 = output off)
+void setFrameTicks(int servo, uint16_t ticks) {
+  if (frameTicks[servo] != ticks) {
+    frameTicks[servo] = ticks;
+    frameDirty |= (1UL << servo);
+  }
+}
+
+// Stage an angle (cdeg) for a channel and record it as the current position
+void setFrameAngle(int servo, uint16_t cdeg) {
+  servoPositions[servo] = cdeg;
+  posePending = true;
+  setFrameTicks(servo, angleToPWM(servo, cdeg));
+}
+
+// Set where a joint should go (cdeg); the output limiter gets it there
+void setJointCommand(int servo, uint16_t cdeg) {
+  poseCommand[servo] = cdeg;
+}
+
+// Write channels first..last of a board in one auto-increment burst
+// starting at LEDn_ON_L of the first
+void busBurst(int board, int first, int last) {
+  Wire.beginTransmission(boardAddress[board]);
+  Wire.write(PCA9685_LED0_ON_L + 4 * first);
+  for (int ch = first; ch <= last; ch++) {
+    int servo = boardJoint[board][ch];
+    uint16_t ticks = servo >= 0 ? frameTicks[servo] : 0;
+    uint16_t on = ticks ? channelPhase[servo] : 0;   // off stays ON = OFF = 0
+    uint16_t off = (on + ticks) % PCA9685_PERIOD;
+    Wire.write(on & 0xFF);   // ON_L
+    Wire.write(on >> 8);     // ON_H
+    Wire.write(off & 0xFF);  // OFF_L
+    Wire.write(off >> 8);    // OFF_H
+  }
+  busCount(boardStats[board], Wire.endTransmission(), 2 + 4 * (last - first + 1));
+}
+
+// Flush the shadow frame, one burst per run of adjacent dirty channels on
+// a board. A clean channel inside a burst would cost four data bytes, more
+// than the address and register bytes of starting a new one.
+void commitFrame() {
+  METRIC_SCOPE(METRIC_I2C_COMMIT);
+  pwmDigestFrame(frameDirty);
+
+  uint32_t boardDirty[PCA9685_BOARDS] = {};
+  for (uint32_t dirty = frameDirty; dirty; dirty &= dirty - 1) {
+    const ServoChannel &out = servoMap[__builtin_ctz(dirty)];
+    boardDirty[out.board] |= 1U << out.channel;
+  }
+  for (int b = 0; b < PCA9685_BOARDS; b++) {
+    uint32_t dirty = boardDirty[b];
+    while (dirty) {
+      int first = __builtin_ctz(dirty);
+      int last = first + __builtin_ctz(~(dirty >> first)) - 1;
+      busBurst(b, first, last);
+      dirty &= ~0U << (last + 1);
+    }
+  }
+
+  frameDirty = 0;
+}
+
+// Switch every output off at once: one all-call write reaches every board
+void releaseServos() {
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    setFrameTicks(i, 0);
+  }
+  pwmDigestFrame(frameDirty);
+  frameDirty = 0;
+
+  Wire.beginTransmission(PCA9685_ALLCALL_ADDRESS);
+  Wire.write(PCA9685_ALLLED_ON_L);
+  for (int i = 0; i < 4; i++) Wire.write(0);   // ON = OFF = 0
+  busCount(allCallStats, Wire.endTransmission(), 6);
+}
+
+// Motion scheduler: keyframes are queued by handlers and interpolated at a
+// fixed rate from loop(), so no request handler ever blocks on a move.
+#define MOTION_TICK_US 10000UL  // 100 Hz
+#define MOTION_TICK_MS (MOTION_TICK_US / 1000)
+#define MOTION_QUEUE_LEN 48
+
+enum Easing : uint8_t { EASE_LINEAR, EASE_MIN_JERK };
+
+struct Keyframe {
+  uint16_t angles[NUM_SERVOS];   // cdeg
+  uint16_t durationMs;
+  uint16_t jobId;
+  Easing easing;
+};
+
+struct MotionStats {
+  uint32_t ticks;
+  uint32_t overruns;    // ticks that fell a whole period behind
+  uint32_t lateMaxUs;   // worst tick start lateness
+  uint64_t lateSumUs;
+};
+
+Keyframe motionQueue[MOTION_QUEUE_LEN];
+uint8_t motionHead = 0;
+uint8_t motionCount = 0;
+uint16_t activeJobId = 0;      // 0 = idle
+uint16_t lastDoneJobId = 0;
+
+bool gaitActive = false;       // gait runs whenever the queue is empty
+
+bool keyframeRunning = false;
+uint16_t keyframeStart[NUM_SERVOS];
+uint32_t keyframeElapsedMs = 0;
+
+MotionStats motionStats;
+uint32_t motionNextTickUs = 0;
+
+bool motionEnqueue(const uint16_t *angles, uint16_t durationMs, Easing easing, uint16_t jobId) {
+  if (motionCount >= MOTION_QUEUE_LEN) return false;
+
+  Keyframe &kf = motionQueue[(motionHead + motionCount) % MOTION_QUEUE_LEN];
+  memcpy(kf.angles, angles, sizeof(kf.angles));
+  kf.durationMs = durationMs;
+  kf.easing = easing;
+  kf.jobId = jobId;
+  motionCount++;
+  return true;
+}
+
+// Drop queued and running keyframes and stop walking; joints stay put
+void motionCancel() {
+  gaitActive = false;
+  motionCount = 0;
+  keyframeRunning = false;
+  activeJobId = 0;
+}
+
+// Advance the head keyframe by one tick and stage the interpolated pose
+void motionTick() {
+  METRIC_SCOPE(METRIC_MOTION_TICK);
+  if (motionCount == 0) {
+    if (gaitActive) gaitTick();
+    return;
+  }
+
+  Keyframe &kf = motionQueue[motionHead];
+  if (!keyframeRunning) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      keyframeStart[i] = poseCommand[i];
+    }
+    keyframeElapsedMs = 0;
+    keyframeRunning = true;
+    activeJobId = kf.jobId;
+  }
+
+  keyframeElapsedMs += MOTION_TICK_MS;
+  bool done = keyframeElapsedMs >= kf.durationMs;
+
+  // Progress along the move in Q16
+  uint32_t s = 65536;
+  if (!done) {
+    uint32_t t = (keyframeElapsedMs << 16) / kf.durationMs;
+    s = t;
+    if (kf.easing == EASE_MIN_JERK) {
+      // Minimum-jerk profile: t^3 (10 - 15t + 6t^2)
+      uint32_t t2 = (t * t) >> 16;
+      uint32_t t3 = (t2 * t) >> 16;
+      uint32_t poly = 10 * 65536 - 15 * t + 6 * t2;
+      s = ((uint64_t)t3 * poly) >> 16;
+    }
+  }
+
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    int32_t delta = (int32_t)kf.angles[i] - keyframeStart[i];
+    setJointCommand(i, keyframeStart[i] + ((delta * (int32_t)s + 32768) >> 16));
+  }
+
+  if (done) {
+    keyframeRunning = false;
+    motionHead = (motionHead + 1) % MOTION_QUEUE_LEN;
+    motionCount--;
+    if (motionCount == 0 || motionQueue[motionHead].jobId != kf.jobId) {
+      lastDoneJobId = kf.jobId;
+      activeJobId = 0;
+    }
+  }
+}
+
+// Leg inverse kinematics. Servo layout is three channels per leg:
+// coxa = 3*leg, femur = 3*leg + 1, tibia = 3*leg + 2.
+// Body frame is x forward, y left, z up, in millimetres. Angles are in
+// centi-degrees and the solver uses only integer math on the hot path.
+#define NUM_LEGS 6
+#define LEG_COXA(leg) ((leg) * 3)
+#define LEG_FEMUR(leg) ((leg) * 3 + 1)
+#define LEG_TIBIA(leg) ((leg) * 3 + 2)
+
+struct LegMount {
+  int16_t x, y;     // coxa pivot position (mm)
+  int16_t angle;    // outward direction of the leg (cdeg, 0 = forward)
+};
+
+struct LegGeometry {
+  int16_t coxaLen, femurLen, tibiaLen;  // mm
+  // Servo angle (cdeg) for coxa straight out, femur horizontal and tibia
+  // square to the femur, and the sign that maps joint angle to servo angle
+  int16_t coxaZero, femurZero, tibiaZero;
+  int8_t coxaDir, femurDir, tibiaDir;
+  LegMount legs[NUM_LEGS];
+};
+
+// Default geometry; measure and adjust for the actual frame
+LegGeometry legGeometry = {
+  50, 65, 120,
+  9000, 9000, 9000,
+  1, -1, 1,
+  {
+    {  60, -40,  -4500 },  // front right
+    {   0, -60,  -9000 },  // middle right
+    { -60, -40, -13500 },  // rear right
+    { -60,  40,  13500 },  // rear left
+    {   0,  60,   9000 },  // middle left
+    {  60,  40,   4500 },  // front left
+  }
+};
+
+// atan(k/256) in 1/8 cdeg for k = 0..256, plus a guard entry for
+// interpolation. The extra bits keep table rounding out of the result.
+#define ATAN_TABLE_FRAC 3
+uint16_t atanTable[258];
+// Per-leg mount rotation in Q14, derived from legGeometry by ikInit()
+int16_t mountCos[NUM_LEGS], mountSin[NUM_LEGS];
+
+uint32_t ikSolveMicros = 0;  // duration of the last ikSolveAll()
+
+// Build lookup tables; call again after changing legGeometry
+void ikInit() {
+  for (int k = 0; k <= 256; k++) {
+    atanTable[k] = lroundf(atanf(k / 256.0f) * (18000 << ATAN_TABLE_FRAC) / (float)M_PI);
+  }
+  atanTable[257] = atanTable[256];
+
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    float a = legGeometry.legs[leg].angle * (float)M_PI / 18000.0f;
+    mountCos[leg] = lroundf(cosf(a) * 16384.0f);
+    mountSin[leg] = lroundf(sinf(a) * 16384.0f);
+  }
+}
+
+uint32_t isqrt(uint32_t n) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > n) bit >>= 2;
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+// Integer atan2 in cdeg, range (-18000, 18000]
+int32_t iatan2(int32_t y, int32_t x) {
+  uint32_t ax = x < 0 ? -x : x;
+  uint32_t ay = y < 0 ? -y : y;
+  if (ax == 0 && ay == 0) return 0;
+
+  // Keep the Q16 ratio inside 32 bits
+  while ((ax | ay) >= 32768) {
+    ax >>= 1;
+    ay >>= 1;
+  }
+
+  bool steep = ay > ax;
+  // Round the ratio and the interpolation rather than truncating, which
+  // would bias every angle low by up to a cdeg
+  uint32_t q = steep ? ((ax << 16) + ay / 2) / ay : ((ay << 16) + ax / 2) / ax;
+  uint32_t idx = q >> 8, frac = q & 0xFF;
+  int32_t fine = atanTable[idx] + (((atanTable[idx + 1] - atanTable[idx]) * (int32_t)frac + 128) >> 8);
+  int32_t angle = (fine + (1 << (ATAN_TABLE_FRAC - 1))) >> ATAN_TABLE_FRAC;
+
+  if (steep) angle = 9000 - angle;
+  if (x < 0) angle = 18000 - angle;
+  return y < 0 ? -angle : angle;
+}
+
+// Square root rounded to nearest, for 64-bit fixed-point lengths
+uint32_t isqrt64(uint64_t n) {
+  uint64_t root = 0;
+  uint64_t bit = 1ULL << 62;
+  while (bit > n) bit >>= 2;
+  while (bit) {
+    if (n >= root + bit) {
+      n -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  // Round to nearest: the remainder exceeds root when (root + 0.5)^2 < n
+  return (uint32_t)(n > root ? root + 1 : root);
+}
+
+// acos(num / sqrt(den2)) in cdeg, expressed through atan2 to reuse one
+// table. Taking the denominator squared lets callers pass exact
+// law-of-cosines terms instead of a rounded root.
+int32_t iacos(int64_t num, int64_t den2) {
+  int64_t rem = den2 - num * num;
+  if (rem <= 0) return num >= 0 ? 0 : 18000;
+  // Scale den2 into [2^58, 2^60) so sqrt(rem) and num keep 30 bits
+  int shift = 0;
+  while (den2 < (1LL << 58)) {
+    den2 <<= 2;
+    rem <<= 2;
+    shift++;
+  }
+  while (den2 >= (1LL << 60)) {
+    den2 >>= 2;
+    rem >>= 2;
+    shift--;
+  }
+  num = shift >= 0 ? num * (1LL << shift) : num >> -shift;
+  return iatan2(isqrt64(rem), num);
+}
+
+// Sub-mm bits in the leg-frame lengths. The law-of-cosines terms are
+// squared again in 64 bits, which holds for links up to about 500 mm.
+#define IK_FRAC_BITS 6
+
+// Solve one leg for a foot target in the body frame. Writes servo angles
+// (cdeg, coxa/femur/tibia) and returns false if the target is out of reach.
+bool ikSolveLeg(int leg, int32_t x, int32_t y, int32_t z, int16_t out[3]) {
+  const LegGeometry &g = legGeometry;
+  const LegMount &m = g.legs[leg];
+
+  // Rotate into the leg frame: x outward along the coxa, y to its left.
+  // Lengths from here on carry IK_FRAC_BITS fractional bits; whole-mm
+  // rounding of r and d cost up to several degrees near full reach.
+  int32_t dx = x - m.x, dy = y - m.y;
+  int32_t half = 1 << (13 - IK_FRAC_BITS);
+  int32_t lx = (dx * mountCos[leg] + dy * mountSin[leg] + half) >> (14 - IK_FRAC_BITS);
+  int32_t ly = (dy * mountCos[leg] - dx * mountSin[leg] + half) >> (14 - IK_FRAC_BITS);
+
+  int32_t coxa = iatan2(ly, lx);
+  int64_t r = (int64_t)isqrt64((int64_t)lx * lx + (int64_t)ly * ly) - ((int64_t)g.coxaLen << IK_FRAC_BITS);
+  int64_t zq = (int64_t)z * (1 << IK_FRAC_BITS);   // z is negative below the hip
+
+  int64_t d2 = r * r + zq * zq;
+  int64_t reachMax = (int64_t)(g.femurLen + g.tibiaLen) << IK_FRAC_BITS;
+  int64_t reachMin = (int64_t)(g.femurLen - g.tibiaLen) * (1 << IK_FRAC_BITS);
+  if (d2 > reachMax * reachMax || d2 < reachMin * reachMin || d2 == 0) return false;
+
+  int64_t f = (int64_t)g.femurLen << IK_FRAC_BITS, t = (int64_t)g.tibiaLen << IK_FRAC_BITS;
+  int64_t f2 = f * f, t2 = t * t;
+  // Femur elevation: angle to the foot plus the triangle angle at the hip,
+  // acos((f2 + d2 - t2) / 2fd) with 4f2d2 standing in for (2fd)^2
+  int32_t femur = iatan2((int32_t)zq, (int32_t)r) + iacos(f2 + d2 - t2, 4 * f2 * d2);
+  // Knee interior angle, 9000 when the tibia is square to the femur
+  int32_t knee = iacos(f2 + t2 - d2, 4 * f2 * t2);
+
+  out[0] = g.coxaZero + g.coxaDir * coxa;
+  out[1] = g.femurZero + g.femurDir * femur;
+  out[2] = g.tibiaZero + g.tibiaDir * (knee - 9000);
+  return true;
+}
+
+// Solve all six legs into a pose (cdeg). Legs whose target is out of reach
+// keep their entry in pose unchanged.
+bool ikSolveAll(const int16_t feet[NUM_LEGS][3], uint16_t pose[NUM_SERVOS]) {
+  uint32_t start = micros();
+  bool ok = true;
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    int16_t joints[3];
+    if (!ikSolveLeg(leg, feet[leg][0], feet[leg][1], feet[leg][2], joints)) {
+      ok = false;
+      continue;
+    }
+    for (int j = 0; j < 3; j++) {
+      pose[leg * 3 + j] = constrain(joints[j], 0, CDEG_MAX);
+    }
+  }
+  ikSolveMicros = micros() - start;
+  return ok;
+}
+
+// Gait generator. Each leg follows the same stance/swing cycle shifted by a
+// per-gait phase offset. Phases are Q16 fractions of a cycle so that
+// uint16_t arithmetic wraps for free; nothing here allocates.
+#define GAIT_CYCLE_MS 1200
+#define GAIT_STAND_REACH 80     // mm from coxa tip to foot, horizontally
+#define GAIT_STAND_HEIGHT 80    // mm from coxa pivot down to foot
+#define GAIT_STEP_HEIGHT 30     // mm
+#define GAIT_MAX_STRIDE 60      // mm per stance, per axis
+
+enum GaitType : uint8_t { GAIT_TRIPOD, GAIT_WAVE, GAIT_RIPPLE, GAIT_COUNT };
+
+struct GaitPattern {
+  const char *name;
+  uint16_t duty;                  // stance fraction, Q16
+  uint16_t offset[NUM_LEGS];      // phase offset per leg, Q16
+};
+
+// Leg order: front right, middle right, rear right, rear left, middle left,
+// front left
+const GaitPattern gaitPatterns[GAIT_COUNT] = {
+  { "tripod", 32768, { 0, 32768, 0, 32768, 0, 32768 } },
+  { "wave",   54613, { 21845, 10923, 0, 32768, 43691, 54613 } },
+  { "ripple", 43691, { 43691, 21845, 0, 32768, 54613, 10923 } },
+};
+
+struct GaitStats {
+  uint32_t ticks;
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+};
+
+GaitType gaitType = GAIT_TRIPOD;
+uint16_t gaitPhase = 0;
+int16_t gaitNeutral[NUM_LEGS][2];   // neutral foot x/y in the body frame
+int16_t gaitStride[NUM_LEGS][2];    // foot travel over one stance
+GaitStats gaitStats;
+
+// Foot straight out from its coxa at the standing reach, body frame x/y
+void legNeutralFoot(int leg, int16_t &x, int16_t &y) {
+  const LegGeometry &g = legGeometry;
+  int32_t reach = g.coxaLen + GAIT_STAND_REACH;
+  x = g.legs[leg].x + ((reach * mountCos[leg]) >> 14);
+  y = g.legs[leg].y + ((reach * mountSin[leg]) >> 14);
+}
+
+void gaitComputeNeutral() {
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    legNeutralFoot(leg, gaitNeutral[leg][0], gaitNeutral[leg][1]);
+  }
+}
+
+// Set the body velocity (mm/s) and turn rate (cdeg/s, counter-clockwise).
+// Strides are worked out here so the tick only interpolates.
+void gaitSetCommand(int16_t vx, int16_t vy, int16_t turn) {
+  int32_t stanceMs = ((uint32_t)GAIT_CYCLE_MS * gaitPatterns[gaitType].duty) >> 16;
+  float omega = turn * (float)M_PI / 18000.0f;  // rad/s
+
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    // Foot velocity relative to the body is -(v + omega x r); the stance
+    // sweeps from +stride/2 to -stride/2 so the stride is (v + omega x r) * T
+    float sx = (vx - omega * gaitNeutral[leg][1]) * stanceMs / 1000.0f;
+    float sy = (vy + omega * gaitNeutral[leg][0]) * stanceMs / 1000.0f;
+    gaitStride[leg][0] = constrain(lroundf(sx), -GAIT_MAX_STRIDE, GAIT_MAX_STRIDE);
+    gaitStride[leg][1] = constrain(lroundf(sy), -GAIT_MAX_STRIDE, GAIT_MAX_STRIDE);
+  }
+}
+
+// Stage one gait tick: advance the phase, place every foot, solve IK
+void gaitTick() {
+  uint32_t start = micros();
+  const GaitPattern &pat = gaitPatterns[gaitType];
+
+  gaitPhase += (uint16_t)((65536UL * MOTION_TICK_MS) / GAIT_CYCLE_MS);
+
+  int16_t feet[NUM_LEGS][3];
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    uint16_t p = gaitPhase + pat.offset[leg];
+    int32_t along;  // Q16 position along the stride, -0.5 .. +0.5
+    int32_t lift = 0;
+
+    if (p < pat.duty) {
+      uint32_t u = ((uint32_t)p << 16) / pat.duty;
+      along = 32768 - (int32_t)u;
+    } else {
+      uint32_t u = ((uint32_t)(p - pat.duty) << 16) / (65536UL - pat.duty);
+      along = (int32_t)u - 32768;
+      // Parabolic lift, 4u(1-u) in Q16
+      lift = (GAIT_STEP_HEIGHT * (int32_t)((u >> 8) * ((65536 - u) >> 8) * 4)) >> 16;
+    }
+
+    feet[leg][0] = gaitNeutral[leg][0] + ((gaitStride[leg][0] * along) >> 16);
+    feet[leg][1] = gaitNeutral[leg][1] + ((gaitStride[leg][1] * along) >> 16);
+    feet[leg][2] = -GAIT_STAND_HEIGHT + lift;
+  }
+
+  uint16_t pose[NUM_SERVOS];
+  memcpy(pose, poseCommand, sizeof(pose));
+  ikSolveAll(feet, pose);
+  for (int i = 0; i < NUM_SERVOS; i++) setJointCommand(i, pose[i]);
+
+  uint32_t elapsed = micros() - start;
+  gaitStats.ticks++;
+  gaitStats.lastUs = elapsed;
+  gaitStats.sumUs += elapsed;
+  if (elapsed > gaitStats.maxUs) gaitStats.maxUs = elapsed;
+}
+
+// Neutral standing pose for the current geometry, used to enter and leave
+// the gait smoothly
+void gaitNeutralPose(uint16_t pose[NUM_SERVOS]) {
+  int16_t feet[NUM_LEGS][3];
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    feet[leg][0] = gaitNeutral[leg][0];
+    feet[leg][1] = gaitNeutral[leg][1];
+    feet[leg][2] = -GAIT_STAND_HEIGHT;
+  }
+  memcpy(pose, poseCommand, sizeof(poseCommand));
+  ikSolveAll(feet, pose);
+}
+
+// Start walking: ease into the neutral stance, then hand over to the gait.
+// While walking the same gait only the strides change. A different gait
+// moves every leg's phase offset, so it goes back through the neutral
+// stance rather than jumping feet between stance and swing.
+bool gaitStart(GaitType type, int16_t vx, int16_t vy, int16_t turn, uint16_t jobId) {
+  uint16_t pose[NUM_SERVOS];
+  bool sameGait = gaitActive && type == gaitType;
+
+  gaitType = type;
+  gaitComputeNeutral();
+  gaitSetCommand(vx, vy, turn);
+  if (sameGait) return true;
+
+  motionCancel();
+  gaitNeutralPose(pose);
+  if (!motionEnqueue(pose, 400, EASE_MIN_JERK, jobId)) return false;
+  gaitPhase = 0;
+  gaitActive = true;
+  return true;
+}
+
+// Stop walking and settle all feet back to the neutral stance
+void gaitStop(uint16_t jobId) {
+  if (!gaitActive) return;
+  uint16_t pose[NUM_SERVOS];
+  motionCancel();
+  gaitNeutralPose(pose);
+  motionEnqueue(pose, 400, EASE_MIN_JERK, jobId);
+}
+
+// Body pose controller. The feet stay planted on the neutral stance while
+// the body is shifted (mm) and tilted (cdeg) above them: each foot's world
+// position is moved into the displaced body frame, foot = R^T (world - T)
+// with R = Rz(yaw) Ry(pitch) Rx(roll), and solved with the leg IK. Foot
+// targets are rounded to whole millimetres and every leg keeps its last few
+// solutions, so only legs whose target changed go through the solver and
+// returning to a recent pose costs no IK at all. Runs on the producer side
+// under apiLock, never in the motion tick.
+#define BODY_MAX_SHIFT 40     // mm, per axis
+#define BODY_MAX_TILT 2000    // cdeg, roll and pitch
+#define BODY_MAX_YAW 3000     // cdeg
+#define BODY_MOVE_MS 300      // default transition for HTTP body moves
+#define BODY_CACHE_WAYS 4
+
+struct BodyPose {
+  int16_t x, y, z;            // mm, z up
+  int16_t roll, pitch, yaw;   // cdeg
+};
+
+struct LegSolution {
+  int16_t foot[3];      // target in the body frame (mm)
+  int16_t joints[3];    // cdeg, coxa/femur/tibia
+  bool reachable;
+  bool used;
+};
+
+struct BodyStats {
+  uint32_t poses;       // poses solved
+  uint32_t rejected;    // poses with a leg out of reach
+  uint32_t legHits;     // legs served from the cache
+  uint32_t legSolves;   // legs run through the IK
+  uint32_t lastUs;
+  uint32_t maxUs;
+};
+
+int16_t bodyNeutral[NUM_LEGS][3];   // planted feet, body frame at rest
+LegSolution bodyCache[NUM_LEGS][BODY_CACHE_WAYS];
+uint8_t bodyCacheLast[NUM_LEGS];    // way of each leg's previous solution
+uint8_t bodyCacheNext[NUM_LEGS];    // round-robin victim
+BodyPose bodyPose = {};             // last pose handed to the motion side
+BodyStats bodyStats;
+
+// Plant the feet and drop cached solutions; call again after ikInit()
+void bodyInit() {
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    legNeutralFoot(leg, bodyNeutral[leg][0], bodyNeutral[leg][1]);
+    bodyNeutral[leg][2] = -GAIT_STAND_HEIGHT;
+  }
+  memset(bodyCache, 0, sizeof(bodyCache));
+  memset(bodyCacheLast, 0, sizeof(bodyCacheLast));
+  memset(bodyCacheNext, 0, sizeof(bodyCacheNext));
+}
+
+bool bodyInRange(const BodyPose &b) {
+  return abs(b.x) <= BODY_MAX_SHIFT && abs(b.y) <= BODY_MAX_SHIFT &&
+         abs(b.z) <= BODY_MAX_SHIFT && abs(b.roll) <= BODY_MAX_TILT &&
+         abs(b.pitch) <= BODY_MAX_TILT && abs(b.yaw) <= BODY_MAX_YAW;
+}
+
+// Look up or solve one leg; the previous solution is tried first
+const LegSolution &bodySolveLeg(int leg, const int16_t foot[3]) {
+  LegSolution *ways = bodyCache[leg];
+  uint8_t last = bodyCacheLast[leg];
+  for (int k = 0; k < BODY_CACHE_WAYS; k++) {
+    uint8_t w = (last + k) % BODY_CACHE_WAYS;
+    if (ways[w].used && memcmp(ways[w].foot, foot, sizeof(ways[w].foot)) == 0) {
+      bodyStats.legHits++;
+      bodyCacheLast[leg] = w;
+      return ways[w];
+    }
+  }
+
+  uint8_t w = bodyCacheNext[leg];
+  bodyCacheNext[leg] = (w + 1) % BODY_CACHE_WAYS;
+  bodyCacheLast[leg] = w;
+
+  LegSolution &sol = ways[w];
+  memcpy(sol.foot, foot, sizeof(sol.foot));
+  sol.used = true;
+  sol.reachable = ikSolveLeg(leg, foot[0], foot[1], foot[2], sol.joints);
+  // A joint past the servo's travel would be clamped and miss the foot
+  for (int j = 0; j < 3 && sol.reachable; j++) {
+    if (sol.joints[j] < 0 || sol.joints[j] > CDEG_MAX) sol.reachable = false;
+  }
+  bodyStats.legSolves++;
+  return sol;
+}
+
+// Joint pose that holds the feet planted with the body at b. Returns false,
+// leaving pose untouched, if any leg cannot reach its foot.
+bool bodySolve(const BodyPose &b, uint16_t pose[NUM_SERVOS]) {
+  uint32_t start = micros();
+  const float k = (float)M_PI / 18000.0f;
+  float cr = cosf(b.roll * k), sr = sinf(b.roll * k);
+  float cp = cosf(b.pitch * k), sp = sinf(b.pitch * k);
+  float cy = cosf(b.yaw * k), sy = sinf(b.yaw * k);
+
+  // Rows of R^T, i.e. the columns of R
+  const float rt[3][3] = {
+    { cy * cp, sy * cp, -sp },
+    { cy * sp * sr - sy * cr, sy * sp * sr + cy * cr, cp * sr },
+    { cy * sp * cr + sy * sr, sy * sp * cr - cy * sr, cp * cr },
+  };
+
+  uint16_t out[NUM_SERVOS];
+  bool ok = true;
+  for (int leg = 0; leg < NUM_LEGS && ok; leg++) {
+    float v[3] = {
+      (float)(bodyNeutral[leg][0] - b.x),
+      (float)(bodyNeutral[leg][1] - b.y),
+      (float)(bodyNeutral[leg][2] - b.z),
+    };
+    int16_t foot[3];
+    for (int r = 0; r < 3; r++) {
+      foot[r] = lroundf(rt[r][0] * v[0] + rt[r][1] * v[1] + rt[r][2] * v[2]);
+    }
+
+    const LegSolution &sol = bodySolveLeg(leg, foot);
+    ok = sol.reachable;
+    for (int j = 0; j < 3; j++) out[leg * 3 + j] = sol.joints[j];
+  }
+
+  uint32_t elapsed = micros() - start;
+  bodyStats.lastUs = elapsed;
+  if (elapsed > bodyStats.maxUs) bodyStats.maxUs = elapsed;
+  if (!ok) {
+    bodyStats.rejected++;
+    return false;
+  }
+  bodyStats.poses++;
+  memcpy(pose, out, sizeof(out));
+  return true;
+}
+
+// Output limiter between the commanded pose and the PWM. Once per tick each
+// joint's output steps toward its command with bounded velocity and
+// acceleration, decelerating in time to stop on the target. An estimated
+// supply current is shared between the joints: a moving servo is assumed
+// to draw in proportion to its speed, up to jointMa at
+// LIMIT_FULL_SPEED_DPS, and a servo starting from rest draws a full jointMa
+// surge. Joints already moving are served first, and joints that cannot
+// afford their start wait for a later tick, so a large move is staggered
+// instead of all 18 servos drawing inrush at once.
+#define LIMIT_FULL_SPEED_DPS 600   // typical no-load servo speed
+
+struct LimitSetting {
+  uint16_t maxVel;     // deg/s, 0 = unlimited
+  uint16_t maxAccel;   // deg/s^2, 0 = unlimited
+  uint16_t jointMa;    // estimated draw of one servo at full speed
+  uint16_t budgetMa;   // 0 = unlimited
+};
+
+struct LimitStats {
+  uint8_t moving;         // joints that moved on the last tick
+  uint8_t movingPeak;
+  uint16_t currentMa;     // estimated draw on the last tick
+  uint16_t currentPeakMa;
+  uint32_t deferrals;     // joint-ticks slowed by the current budget
+};
+
+// Tick-domain limits, Q8 cdeg per tick and per tick^2; 0 = unlimited
+int32_t limitVmax[NUM_SERVOS];
+int32_t limitAmax[NUM_SERVOS];
+uint16_t limitJointMa = 0;
+uint16_t limitBudgetMa = 0;
+
+int32_t limitOut[NUM_SERVOS];   // output position, Q8 cdeg
+int32_t limitVel[NUM_SERVOS];   // Q8 cdeg per tick
+LimitStats limitStats;
+
+// Full speed in Q8 cdeg per tick, the reference for the current estimate
+#define LIMIT_FULL_SPEED_Q8 ((int32_t)((uint64_t)LIMIT_FULL_SPEED_DPS * 25600 * MOTION_TICK_US / 1000000))
+
+void limitApply(uint32_t mask, const LimitSetting &set) {
+  int32_t vmax = (uint64_t)set.maxVel * 25600 * MOTION_TICK_US / 1000000;
+  int32_t amax = (uint64_t)set.maxAccel * 25600 * MOTION_TICK_US * MOTION_TICK_US / 1000000000000ULL;
+  if (set.maxAccel && amax == 0) amax = 1;
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (!(mask & (1UL << i))) continue;
+    limitVmax[i] = vmax;
+    limitAmax[i] = amax;
+  }
+  limitJointMa = set.jointMa;
+  limitBudgetMa = set.budgetMa;
+}
+
+// Output snaps to the current position, with nothing left to do
+void limitReset() {
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    poseCommand[i] = servoPositions[i];
+    limitOut[i] = (int32_t)servoPositions[i] << 8;
+    limitVel[i] = 0;
+  }
+}
+
+// Velocity one joint wants this tick, before the current budget
+int32_t limitWantVel(int i, int32_t err) {
+  int32_t mag = err < 0 ? -err : err;
+  int32_t want = mag;
+  // Fastest speed from which the joint can still stop on the target
+  if (limitAmax[i]) {
+    int32_t stop = isqrt(2 * limitAmax[i] * (uint32_t)(mag >> 8)) << 4;
+    if (stop < limitAmax[i]) stop = limitAmax[i];
+    if (stop < want) want = stop;
+  }
+  if (limitVmax[i] && limitVmax[i] < want) want = limitVmax[i];
+  if (err < 0) want = -want;
+
+  if (limitAmax[i]) {
+    int32_t v = limitVel[i];
+    want = constrain(want, v - limitAmax[i], v + limitAmax[i]);
+  }
+  return want;
+}
+
+// Estimated draw of a joint moving mag Q8 cdeg this tick
+int32_t limitCost(int32_t mag) {
+  int32_t cost = (int64_t)limitJointMa * mag / LIMIT_FULL_SPEED_Q8;
+  return cost > limitJointMa ? limitJointMa : cost;
+}
+
+// Step every joint's output toward its command and stage the PWM
+void limitTick() {
+  int32_t budget = limitBudgetMa ? limitBudgetMa : INT32_MAX;
+  uint32_t used = 0;
+  uint8_t moving = 0;
+
+  // Reserve what moving joints draw even at their hardest braking, so
+  // joints served early cannot starve later ones of it
+  uint32_t inMotion = 0;
+  int32_t floorMag[NUM_SERVOS] = {};
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (limitVel[i] == 0) continue;
+    inMotion |= (1UL << i);
+    int32_t mag = limitVel[i] < 0 ? -limitVel[i] : limitVel[i];
+    floorMag[i] = limitAmax[i] && mag > limitAmax[i] ? mag - limitAmax[i] : 0;
+    if (limitBudgetMa) budget -= limitCost(floorMag[i]);
+  }
+
+  // Joints already in motion first, then joints starting from rest
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      bool starting = !(inMotion & (1UL << i));
+      if (starting != (pass == 1)) continue;
+      if (limitBudgetMa) budget += limitCost(floorMag[i]);
+
+      int32_t err = ((int32_t)poseCommand[i] << 8) - limitOut[i];
+      if (err == 0) {
+        limitVel[i] = 0;
+        continue;
+      }
+
+      int32_t v = limitWantVel(i, err);
+      int32_t mag = v < 0 ? -v : v;
+      int32_t cost = 0;
+      if (limitJointMa) cost = starting ? limitJointMa : limitCost(mag);
+
+      if (cost > budget) {
+        limitStats.deferrals++;
+        if (starting) {
+          // Not enough headroom for the start surge; try again next tick
+          continue;
+        }
+        // Slow down to what the budget allows, but never brake harder
+        // than the acceleration limit
+        int32_t allowed = budget > 0 ? (int64_t)budget * LIMIT_FULL_SPEED_Q8 / limitJointMa : 0;
+        if ((limitVel[i] ^ v) >= 0 && allowed < floorMag[i]) allowed = floorMag[i];
+        if (allowed < mag) {
+          mag = allowed;
+          v = v < 0 ? -mag : mag;
+        }
+        cost = limitCost(mag);
+      }
+      budget -= cost;
+      used += cost;
+
+      // Land exactly on the target instead of stepping past it
+      if ((err > 0 && v >= err) || (err < 0 && v <= err)) v = err;
+      limitOut[i] += v;
+      limitVel[i] = v;
+
+      uint16_t out = (limitOut[i] + 128) >> 8;
+      if (out != servoPositions[i]) {
+        setFrameAngle(i, out);
+        moving++;
+      }
+    }
+  }
+
+  limitStats.moving = moving;
+  limitStats.currentMa = used > 0xFFFF ? 0xFFFF : used;
+  if (moving > limitStats.movingPeak) limitStats.movingPeak = moving;
+  if (limitStats.currentMa > limitStats.currentPeakMa) limitStats.currentPeakMa = limitStats.currentMa;
+}
+
+// Move all servos to center position at once
+void centerServos() {
+  motionCancel();
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    setFrameAngle(i, CDEG(90));  // Center position
+  }
+  limitReset();
+  // Force a full write so the driver matches the shadow frame after boot
+  frameDirty = (1UL << NUM_SERVOS) - 1;
+  commitFrame();
+}
+
+// Initialize all servos to center position
+void initServos() {
+  centerServos();
+  delay(500);
+}
+
+// Motion command ring. Handlers run in loop() and never touch motion state
+// directly: they push commands into a lock-free single-producer /
+// single-consumer ring that the motion tick drains. With MOTION_TASK the
+// tick runs in its own high-priority task on the other core.
+#ifndef MOTION_TASK
+#define MOTION_TASK 1
+#endif
+#define MOTION_CORE 0        // loop(), the web server and OTA run on core 1
+#define MOTION_PRIORITY 20   // above lwIP (18), below the WiFi driver (23)
+#define CMD_RING_LEN 64      // power of two
+
+enum MotionCmdType : uint8_t {
+  CMD_SET_JOINTS,   // cancel motion and set the joints in mask
+  CMD_KEYFRAME,
+  CMD_GAIT,         // gait 0xFF = stop
+  CMD_RELEASE,      // cancel motion and switch every output off
+  CMD_HOLD,         // cancel motion and keep driving the current pose
+  CMD_LIMITS,       // install limits for servo mask
+  CMD_CALIBRATE,    // install cal for one servo
+  CMD_DIGEST_RESET, // restart the PWM output digest
+  CMD_PHASE,        // space pulse ON counts phaseStep counts apart
+};
+
+struct MotionCmd {
+  MotionCmdType type;
+  Easing easing;
+  uint8_t gait;
+  uint8_t servo;      // CMD_CALIBRATE
+  uint16_t jobId;
+  uint16_t durationMs;
+  uint16_t phaseStep; // CMD_PHASE
+  int16_t vx, vy, turn;
+  uint32_t mask;
+  uint32_t pushUs;    // for command-to-PWM latency
+  ServoCal cal;
+  LimitSetting limits;
+  uint16_t angles[NUM_SERVOS];   // cdeg
+};
+
+struct CmdStats {
+  uint32_t pushed;
+  uint32_t dropped;     // ring full
+  uint32_t latMaxUs;
+  uint64_t latSumUs;
+  uint32_t applied;
+};
+
+MotionCmd cmdRing[CMD_RING_LEN];
+std::atomic<uint32_t> cmdHead(0);  // advanced by the consumer
+std::atomic<uint32_t> cmdTail(0);  // advanced by the producer
+CmdStats cmdStats;
+
+// Producer-side state
+uint16_t nextJobId = 1;
+uint16_t motionTarget[NUM_SERVOS];  // pose at the tail of the queue (cdeg)
+
+uint16_t motionNewJob() {
+  uint16_t id = nextJobId++;
+  if (nextJobId == 0) nextJobId = 1;
+  return id;
+}
+
+uint32_t cmdFree() {
+  return CMD_RING_LEN - (cmdTail.load(std::memory_order_relaxed) - cmdHead.load(std::memory_order_acquire));
+}
+
+// Queue a command; issuedUs is when the request behind it arrived
+bool cmdPushAt(MotionCmd &cmd, uint32_t issuedUs) {
+  uint32_t tail = cmdTail.load(std::memory_order_relaxed);
+  if (tail - cmdHead.load(std::memory_order_acquire) >= CMD_RING_LEN) {
+    cmdStats.dropped++;
+    return false;
+  }
+  cmd.pushUs = issuedUs;
+  cmdRing[tail & (CMD_RING_LEN - 1)] = cmd;
+  cmdTail.store(tail + 1, std::memory_order_release);
+  cmdStats.pushed++;
+  return true;
+}
+
+bool cmdPush(MotionCmd &cmd) {
+  return cmdPushAt(cmd, micros());
+}
+
+bool cmdSetJoints(uint32_t mask, const uint16_t *angles) {
+  MotionCmd cmd = {};
+  cmd.type = CMD_SET_JOINTS;
+  cmd.mask = mask;
+  memcpy(cmd.angles, angles, sizeof(cmd.angles));
+  return cmdPush(cmd);
+}
+
+bool cmdKeyframe(const uint16_t *angles, uint16_t durationMs, Easing easing, uint16_t jobId) {
+  MotionCmd cmd = {};
+  cmd.type = CMD_KEYFRAME;
+  cmd.easing = easing;
+  cmd.jobId = jobId;
+  cmd.durationMs = durationMs;
+  memcpy(cmd.angles, angles, sizeof(cmd.angles));
+  if (!cmdPush(cmd)) return false;
+  memcpy(motionTarget, angles, sizeof(motionTarget));
+  return true;
+}
+
+bool cmdKeyframeAll(uint16_t cdeg, uint16_t durationMs, Easing easing, uint16_t jobId) {
+  uint16_t angles[NUM_SERVOS];
+  for (int i = 0; i < NUM_SERVOS; i++) angles[i] = cdeg;
+  return cmdKeyframe(angles, durationMs, easing, jobId);
+}
+
+bool cmdGait(uint8_t gait, int16_t vx, int16_t vy, int16_t turn) {
+  MotionCmd cmd = {};
+  cmd.type = CMD_GAIT;
+  cmd.gait = gait;
+  cmd.vx = vx;
+  cmd.vy = vy;
+  cmd.turn = turn;
+  cmd.jobId = motionNewJob();
+  return cmdPush(cmd);
+}
+
+bool cmdCalibrate(int servo, const ServoCal &cal) {
+  MotionCmd cmd = {};
+  cmd.type = CMD_CALIBRATE;
+  cmd.servo = servo;
+  cmd.cal = cal;
+  return cmdPush(cmd);
+}
+
+bool cmdLimits(uint32_t mask, const LimitSetting &limits) {
+  MotionCmd cmd = {};
+  cmd.type = CMD_LIMITS;
+  cmd.mask = mask;
+  cmd.limits = limits;
+  return cmdPush(cmd);
+}
+
+bool cmdSimple(MotionCmdType type) {
+  MotionCmd cmd = {};
+  cmd.type = type;
+  return cmdPush(cmd);
+}
+
+// Streamed joint commands (WebSocket, UDP): only the latest angle per joint
+// is kept. They bypass the command ring: loop() publishes the pending
+// joints to a mailbox and the motion tick takes whatever is there when it
+// starts, so an update waits for at most one tick however fast they come,
+// and updates that arrive within one tick are coalesced into a single frame.
+struct StreamStats {
+  uint32_t commands;    // joint updates received
+  uint32_t coalesced;   // updates overwritten before they were sent on
+  uint32_t frames;      // frames applied by the motion tick
+  uint32_t latMaxUs;    // oldest-command-to-PWM latency
+  uint64_t latSumUs;
+};
+
+uint16_t streamAngles[NUM_SERVOS];  // cdeg
+uint32_t streamDirty = 0;
+uint32_t streamRxUs = 0;  // arrival of the oldest unsent command
+StreamStats streamStats;
+
+void streamSetJoint(int servo, uint16_t cdeg) {
+  if (streamDirty == 0) streamRxUs = micros();
+  if (streamDirty & (1UL << servo)) streamStats.coalesced++;
+  streamAngles[servo] = cdeg;
+  streamDirty |= (1UL << servo);
+  streamStats.commands++;
+}
+
+// The mailbox is a seqlock like the pose snapshot, written by loop() and
+// read by the tick: mask, arrival of its oldest update, then the joints two
+// per word
+#define STREAM_WORDS (2 + (NUM_SERVOS + 1) / 2)
+
+struct alignas(32) StreamMailbox {
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> words[STREAM_WORDS];
+  std::atomic<uint32_t> takenSeq;   // last seq the tick applied
+};
+
+StreamMailbox streamMailbox;
+uint32_t streamPubMask = 0;   // joints in the mailbox, as loop() left it
+uint32_t streamPubRxUs = 0;
+
+// Publish pending streamed joints. Joints the tick has not taken yet stay
+// in the mailbox alongside them; if it takes a frame while this one is
+// being written, those joints go out again with the same angles.
+void streamFlush() {
+  if (streamDirty == 0) return;
+
+  uint32_t seq = streamMailbox.seq.load(std::memory_order_relaxed);
+  if (streamMailbox.takenSeq.load(std::memory_order_acquire) == seq) streamPubMask = 0;
+  if (streamPubMask == 0) streamPubRxUs = streamRxUs;
+  streamStats.coalesced += __builtin_popcount(streamPubMask & streamDirty);
+  streamPubMask |= streamDirty;
+
+  uint32_t packed[STREAM_WORDS] = { streamPubMask, streamPubRxUs };
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    packed[2 + i / 2] |= (uint32_t)streamAngles[i] << (16 * (i % 2));
+  }
+  streamMailbox.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (int w = 0; w < STREAM_WORDS; w++) {
+    streamMailbox.words[w].store(packed[w], std::memory_order_relaxed);
+  }
+  streamMailbox.seq.store(seq + 2, std::memory_order_release);
+  streamDirty = 0;
+}
+
+// Tick side: apply a frame not taken yet. A frame caught mid-write is left
+// for the next tick rather than waited for, since loop() may share this
+// core. Direct commands override queued motion.
+void streamTake() {
+  uint32_t before = streamMailbox.seq.load(std::memory_order_acquire);
+  if (before == streamMailbox.takenSeq.load(std::memory_order_relaxed) || (before & 1)) return;
+  uint32_t packed[STREAM_WORDS];
+  for (int w = 0; w < STREAM_WORDS; w++) {
+    packed[w] = streamMailbox.words[w].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  if (streamMailbox.seq.load(std::memory_order_relaxed) != before) return;
+  streamMailbox.takenSeq.store(before, std::memory_order_release);
+
+  motionCancel();
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (packed[0] & (1UL << i)) setJointCommand(i, packed[2 + i / 2] >> (16 * (i % 2)));
+  }
+
+  uint32_t latency = micros() - packed[1];
+  streamStats.frames++;
+  streamStats.latSumUs += latency;
+  if (latency > streamStats.latMaxUs) streamStats.latMaxUs = latency;
+}
+
+// Stream a body pose: every joint goes out, only changed legs are solved
+bool bodyStream(const BodyPose &b) {
+  uint16_t pose[NUM_SERVOS];
+  if (!bodyInRange(b) || !bodySolve(b, pose)) return false;
+  for (int i = 0; i < NUM_SERVOS; i++) streamSetJoint(i, pose[i]);
+  bodyPose = b;
+  return true;
+}
+
+// Recorder capture ring. While recording, the motion tick pushes every pose
+// it publishes, stamped with its tick number, whatever path drove it. The
+// recorder in loop() drains the ring and writes the frames to flash, so
+// the tick never touches the filesystem.
+#define REC_RING_LEN 32      // power of two
+
+struct RecFrame {
+  uint32_t tick;
+  uint16_t angles[NUM_SERVOS];   // cdeg
+};
+
+RecFrame recRing[REC_RING_LEN];
+std::atomic<uint32_t> recHead(0);  // advanced by the recorder
+std::atomic<uint32_t> recTail(0);  // advanced by the motion tick
+std::atomic<bool> recActive(false);
+std::atomic<uint32_t> recDropped(0);  // frames lost to a full ring
+
+void recCapture() {
+  uint32_t tail = recTail.load(std::memory_order_relaxed);
+  if (tail - recHead.load(std::memory_order_acquire) >= REC_RING_LEN) {
+    recDropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  RecFrame &frame = recRing[tail & (REC_RING_LEN - 1)];
+  frame.tick = motionStats.ticks;
+  memcpy(frame.angles, servoPositions, sizeof(frame.angles));
+  recTail.store(tail + 1, std::memory_order_release);
+}
+
+// Consumer side: apply one command. Returns false if it has to wait for
+// room in the keyframe queue.
+bool motionApplyCommand(const MotionCmd &cmd) {
+  switch (cmd.type) {
+    case CMD_SET_JOINTS:
+      // Direct commands override queued motion
+      motionCancel();
+      for (int i = 0; i < NUM_SERVOS; i++) {
+        if (cmd.mask & (1UL << i)) setJointCommand(i, cmd.angles[i]);
+      }
+      break;
+    case CMD_KEYFRAME:
+      gaitActive = false;  // Pose moves end walking
+      if (!motionEnqueue(cmd.angles, cmd.durationMs, cmd.easing, cmd.jobId)) return false;
+      break;
+    case CMD_GAIT:
+      if (cmd.gait == 0xFF) {
+        gaitStop(cmd.jobId);
+      } else {
+        gaitStart((GaitType)cmd.gait, cmd.vx, cmd.vy, cmd.turn, cmd.jobId);
+      }
+      break;
+    case CMD_RELEASE:
+      motionCancel();
+      releaseServos();
+      limitReset();
+      break;
+    case CMD_HOLD:
+      motionCancel();
+      break;
+    case CMD_CALIBRATE:
+      servoCal[cmd.servo] = cmd.cal;
+      calBuild(cmd.servo);
+      // Re-drive the joint with its new mapping unless it is switched off
+      if (frameTicks[cmd.servo] != 0) {
+        setFrameAngle(cmd.servo, servoPositions[cmd.servo]);
+      }
+      break;
+    case CMD_LIMITS:
+      limitApply(cmd.mask, cmd.limits);
+      break;
+    case CMD_DIGEST_RESET:
+      pwmDigestReset();
+      break;
+    case CMD_PHASE:
+      phaseApply(cmd.phaseStep);
+      break;
+  }
+  return true;
+}
+
+void motionDrainCommands() {
+  uint32_t head = cmdHead.load(std::memory_order_relaxed);
+  while (head != cmdTail.load(std::memory_order_acquire)) {
+    // Copy before releasing the slot back to the producer
+    MotionCmd cmd = cmdRing[head & (CMD_RING_LEN - 1)];
+    if (!motionApplyCommand(cmd)) break;
+    cmdHead.store(++head, std::memory_order_release);
+
+    uint32_t latency = micros() - cmd.pushUs;
+    cmdStats.applied++;
+    cmdStats.latSumUs += latency;
+    if (latency > cmdStats.latMaxUs) cmdStats.latMaxUs = latency;
+  }
+}
+
+// Motion-owned state the handlers report, published once per tick through
+// a seqlock like the pose. Only fields the motion tick writes belong here;
+// producer-side counters (cmdStats.pushed, streamStats.commands) stay with
+// loop().
+struct MotionStatus {
+  uint64_t lateSumUs;
+  uint64_t gaitSumUs;
+  uint64_t streamLatSumUs;
+  uint64_t cmdLatSumUs;
+  uint32_t ticks;
+  uint32_t overruns;
+  uint32_t lateMaxUs;
+  uint32_t gaitTicks;
+  uint32_t gaitMaxUs;
+  uint32_t streamFrames;
+  uint32_t streamLatMaxUs;
+  uint32_t cmdApplied;
+  uint32_t cmdLatMaxUs;
+  uint32_t deferrals;
+  uint32_t pwmDigest;
+  uint32_t pwmFrames;
+  uint16_t activeJob;
+  uint16_t lastDoneJob;
+  uint8_t queued;
+  uint8_t gait;           // GaitType, 0xFF = idle
+  uint8_t moving;
+  uint8_t movingPeak;
+  uint16_t currentMa;
+  uint16_t currentPeakMa;
+  uint16_t frameTicks[NUM_SERVOS];
+};
+
+#define STATUS_WORDS (sizeof(MotionStatus) / 4)
+static_assert(sizeof(MotionStatus) % 4 == 0, "MotionStatus must pack into whole words");
+
+struct alignas(32) StatusSnapshot {
+  std::atomic<uint32_t> seq;
+  std::atomic<uint32_t> words[STATUS_WORDS];
+};
+
+StatusSnapshot publishedStatus;
+
+// Writer side: only the motion tick calls this
+void statusPublish() {
+  MotionStatus s;
+  s.lateSumUs = motionStats.lateSumUs;
+  s.gaitSumUs = gaitStats.sumUs;
+  s.streamLatSumUs = streamStats.latSumUs;
+  s.cmdLatSumUs = cmdStats.latSumUs;
+  s.ticks = motionStats.ticks;
+  s.overruns = motionStats.overruns;
+  s.lateMaxUs = motionStats.lateMaxUs;
+  s.gaitTicks = gaitStats.ticks;
+  s.gaitMaxUs = gaitStats.maxUs;
+  s.streamFrames = streamStats.frames;
+  s.streamLatMaxUs = streamStats.latMaxUs;
+  s.cmdApplied = cmdStats.applied;
+  s.cmdLatMaxUs = cmdStats.latMaxUs;
+  s.deferrals = limitStats.deferrals;
+  s.pwmDigest = pwmDigest;
+  s.pwmFrames = pwmDigestFrames;
+  s.activeJob = activeJobId;
+  s.lastDoneJob = lastDoneJobId;
+  s.queued = motionCount;
+  s.gait = gaitActive ? gaitType : 0xFF;
+  s.moving = limitStats.moving;
+  s.movingPeak = limitStats.movingPeak;
+  s.currentMa = limitStats.currentMa;
+  s.currentPeakMa = limitStats.currentPeakMa;
+  memcpy(s.frameTicks, frameTicks, sizeof(s.frameTicks));
+
+  uint32_t packed[STATUS_WORDS];
+  memcpy(packed, &s, sizeof(packed));
+  uint32_t seq = publishedStatus.seq.load(std::memory_order_relaxed);
+  publishedStatus.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (unsigned w = 0; w < STATUS_WORDS; w++) {
+    publishedStatus.words[w].store(packed[w], std::memory_order_relaxed);
+  }
+  publishedStatus.seq.store(seq + 2, std::memory_order_release);
+}
+
+// Reader side: copy the status as of the end of one tick
+void statusSnapshot(MotionStatus &out) {
+  uint32_t packed[STATUS_WORDS];
+  uint32_t before, after;
+  do {
+    before = publishedStatus.seq.load(std::memory_order_acquire);
+    for (unsigned w = 0; w < STATUS_WORDS; w++) {
+      packed[w] = publishedStatus.words[w].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    after = publishedStatus.seq.load(std::memory_order_relaxed);
+  } while ((before & 1) || before != after);
+  memcpy(&out, packed, sizeof(packed));
+}
+
+// One motion tick, given how late it started
+void motionStep(uint32_t lateUs) {
+  if (lateUs >= MOTION_TICK_US) motionStats.overruns++;
+  motionStats.ticks++;
+  motionStats.lateSumUs += lateUs;
+  if (lateUs > motionStats.lateMaxUs) motionStats.lateMaxUs = lateUs;
+
+  // Streamed joints first, so commands pushed after them this tick win
+  streamTake();
+  motionDrainCommands();
+  motionTick();
+  limitTick();
+  commitFrame();
+  if (posePending) {
+    if (recActive.load(std::memory_order_relaxed)) recCapture();
+    posePublish();
+  }
+  statusPublish();
+}
+
+// Run due ticks at a fixed rate when polled from loop(). Takes the clock as
+// an argument so the scheduler can be driven by any time source.
+void motionService(uint32_t nowUs) {
+  int32_t late = (int32_t)(nowUs - motionNextTickUs);
+  if (late < 0) return;
+
+  // Fell a whole period behind (blocking handler, WiFi): resync instead
+  // of bursting through the missed ticks
+  if ((uint32_t)late >= MOTION_TICK_US) motionNextTickUs = nowUs;
+  motionNextTickUs += MOTION_TICK_US;
+
+  motionStep(late);
+}
+
+#if MOTION_TASK
+TaskHandle_t motionTaskHandle = nullptr;
+
+// Fixed-rate motion task, pinned away from the network stack
+void motionTask(void *) {
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t expectedUs = micros();
+
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(MOTION_TICK_MS));
+    expectedUs += MOTION_TICK_US;
+    uint32_t now = micros();
+    int32_t late = (int32_t)(now - expectedUs);
+
+    if (late >= (int32_t)MOTION_TICK_US) {
+      // Resync instead of bursting through the missed ticks
+      lastWake = xTaskGetTickCount();
+      expectedUs = now;
+    }
+    motionStep(late > 0 ? late : 0);
+  }
+}
+#endif
+
+// Named pose library. Built-in poses set every leg alike and are expanded
+// into full 18-joint tables at compile time, so moving to one is a copy
+// into the command ring. User poses are captured from the live pose and
+// kept in NVS, one fixed slot each. Transitions are keyframes, eased by the
+// motion tick over the requested duration.
+#define POSE_NAME_LEN 12
+#define POSE_USER_SLOTS 8
+#define POSE_VERSION 1
+#define POSE_MAX_MS 10000
+
+#define POSE_LEG(coxa, femur, tibia) CDEG(coxa), CDEG(femur), CDEG(tibia)
+#define POSE_ALL_LEGS(coxa, femur, tibia) { \
+  POSE_LEG(coxa, femur, tibia), POSE_LEG(coxa, femur, tibia), \
+  POSE_LEG(coxa, femur, tibia), POSE_LEG(coxa, femur, tibia), \
+  POSE_LEG(coxa, femur, tibia), POSE_LEG(coxa, femur, tibia) }
+
+struct NamedPose {
+  char name[POSE_NAME_LEN];
+  uint16_t angles[NUM_SERVOS];   // cdeg
+};
+
+enum BuiltinPose : uint8_t { POSE_STAND, POSE_SIT, POSE_CROUCH, POSE_TALL, POSE_REST, POSE_BUILTIN_COUNT };
+
+// Default angles; adjust for the actual frame
+const NamedPose builtinPoses[POSE_BUILTIN_COUNT] = {
+  { "stand",  POSE_ALL_LEGS(90, 32, 50) },
+  { "sit",    POSE_ALL_LEGS(90, 100, 20) },
+  { "crouch", POSE_ALL_LEGS(90, 60, 35) },
+  { "tall",   POSE_ALL_LEGS(90, 15, 70) },
+  { "rest",   POSE_ALL_LEGS(90, 90, 90) },   // power-on centre
+};
+
+NamedPose userPoses[POSE_USER_SLOTS];   // empty name = free slot
+
+void poseSlotKey(char *key, size_t len, int slot) {
+  snprintf(key, len, "pose%d", slot);
+}
+
+// Load user poses from NVS; prefs is opened by calLoad()
+void poseLoad() {
+  memset(userPoses, 0, sizeof(userPoses));
+  if (prefs.getUShort("poseVer", 0) != POSE_VERSION) return;
+  for (int i = 0; i < POSE_USER_SLOTS; i++) {
+    char key[8];
+    poseSlotKey(key, sizeof(key), i);
+    NamedPose &pose = userPoses[i];
+    if (prefs.getBytes(key, &pose, sizeof(pose)) != sizeof(pose) ||
+        pose.name[POSE_NAME_LEN - 1] != '\0') {
+      memset(&pose, 0, sizeof(pose));
+    }
+  }
+}
+
+void poseSaveSlot(int slot, const NamedPose &pose) {
+  char key[8];
+  poseSlotKey(key, sizeof(key), slot);
+  if (pose.name[0]) {
+    prefs.putBytes(key, &pose, sizeof(NamedPose));
+  } else {
+    prefs.remove(key);
+  }
+  prefs.putUShort("poseVer", POSE_VERSION);
+}
+
+const NamedPose *poseFind(const char *name) {
+  for (int i = 0; i < POSE_BUILTIN_COUNT; i++) {
+    if (strcmp(builtinPoses[i].name, name) == 0) return &builtinPoses[i];
+  }
+  for (int i = 0; i < POSE_USER_SLOTS; i++) {
+    if (userPoses[i].name[0] && strcmp(userPoses[i].name, name) == 0) return &userPoses[i];
+  }
+  return nullptr;
+}
+
+// Ease into a pose instead of snapping all 18 servos at once. Returns the
+// job id, or 0 if the command ring is full.
+uint16_t poseMove(const NamedPose &pose, uint16_t durationMs) {
+  uint16_t job = motionNewJob();
+  if (!cmdKeyframe(pose.angles, durationMs, EASE_MIN_JERK, job)) {
+    Serial.println("Command queue full");
+    return 0;
+  }
+
+  Serial.printf("Robot moving to %s pose\n", pose.name);
+  return job;
+}
+
+// Park the robot for a firmware update: stop walking and settle into the
+// sit pose. The outputs stay driven, and the PCA9685 keeps holding the pose
+// on its own while flash writes stall the CPU.
+void otaHoldPose() {
+  cmdSimple(CMD_HOLD);
+  poseMove(builtinPoses[POSE_SIT], POSE_MOVE_MS);
+}
+
+// Report upload progress and throughput through otaStatus
+void otaSetProgress(size_t done, size_t total) {
+  uint32_t elapsedMs = millis() - otaStartMs;
+  uint32_t rate = elapsedMs ? (uint64_t)done * 1000 / 1024 / elapsedMs : 0;
+  char status[64];
+  snprintf(status, sizeof(status), "Uploading: %u%% (%u KB, %u KB/s)",
+           (unsigned)(total ? (uint64_t)done * 100 / total : 0),
+           (unsigned)(done / 1024), (unsigned)rate);
+  otaStatus = status;
+}
+
+// Setup OTA
+void setupOTA() {
+  // Port defaults to 3232
+  ArduinoOTA.setPort(3232);
+
+  // Hostname defaults to esp32-[MAC]
+  ArduinoOTA.setHostname("ESP32-ServoController");
+
+  // Set password for OTA updates (optional but recommended)
+  ArduinoOTA.setPassword("servo123");
+
+  ArduinoOTA.onStart([]() {
+    ApiGuard guard(portMAX_DELAY);
+    String type;
+    if (ArduinoOTA.getCommand() == U_FLASH)
+      type = "sketch";
+    else // U_SPIFFS
+      type = "filesystem";
+
+    otaInProgress = true;
+    otaStartMs = millis();
+    otaStatus = "Starting " + type + " update...";
+    Serial.println("Start updating " + type);
+    
+    // Hold a safe pose during the update instead of dropping the robot
+    otaHoldPose();
+  });
+
+  ArduinoOTA.onEnd([]() {
+    ApiGuard guard(portMAX_DELAY);
+    otaInProgress = false;
+    otaStatus = "Update Complete - Rebooting...";
+    Serial.println("\nEnd");
+  });
+
+  ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
+    ApiGuard guard(portMAX_DELAY);
+    otaSetProgress(progress, total);
+    Serial.printf("%s\r", otaStatus.c_str());
+  });
+
+  ArduinoOTA.onError([](ota_error_t error) {
+    ApiGuard guard(portMAX_DELAY);
+    otaInProgress = false;
+    Serial.printf("Error[%u]: ", error);
+    if (error == OTA_AUTH_ERROR) {
+      otaStatus = "Auth Failed";
+      Serial.println("Auth Failed");
+    } else if (error == OTA_BEGIN_ERROR) {
+      otaStatus = "Begin Failed";
+      Serial.println("Begin Failed");
+    } else if (error == OTA_CONNECT_ERROR) {
+      otaStatus = "Connect Failed";
+      Serial.println("Connect Failed");
+    } else if (error == OTA_RECEIVE_ERROR) {
+      otaStatus = "Receive Failed";
+      Serial.println("Receive Failed");
+    } else if (error == OTA_END_ERROR) {
+      otaStatus = "End Failed";
+      Serial.println("End Failed");
+    }
+    // The robot stays in the held pose; motion commands work again
+  });
+
+  ArduinoOTA.begin();
+  Serial.println("OTA Ready");
+  Serial.print("IP address: ");
+  Serial.println(WiFi.localIP());
+}
+
+
+// JSON responses are built in one static buffer; the async server copies
+// it into the response, so each reply costs a single allocation
+char responseBuf[1024];
+size_t responseLen = 0;
+
+void respBegin() {
+  responseLen = 0;
+  responseBuf[0] = '\0';
+}
+
+void respRaw(const char *text) {
+  while (*text && responseLen < sizeof(responseBuf) - 1) {
+    responseBuf[responseLen++] = *text++;
+  }
+  responseBuf[responseLen] = '\0';
+}
+
+void respUInt(uint32_t value) {
+  char digits[11];
+  int n = 0;
+  do {
+    digits[n++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  while (n && responseLen < sizeof(responseBuf) - 1) {
+    responseBuf[responseLen++] = digits[--n];
+  }
+  responseBuf[responseLen] = '\0';
+}
+
+// Append "key":[a,b,...] for all joints, converting cdeg to units of scale
+// cdeg with rounding
+void respAngles(const char *key, const uint16_t *cdeg, uint16_t scale) {
+  respRaw("\"");
+  respRaw(key);
+  respRaw("\":[");
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (i) respRaw(",");
+    respUInt((cdeg[i] + scale / 2) / scale);
+  }
+  respRaw("]");
+}
+
+// Append "positions" in whole degrees, as the REST API has always reported
+void respPositions(const uint16_t *cdeg) {
+  respAngles("positions", cdeg, 100);
+}
+
+void respSend(AsyncWebServerRequest *request, int code) {
+  request->send(code, "application/json", responseBuf);
+}
+
+// Request bodies are flat JSON objects of integers and short strings. Each
+// handler lists the fields it accepts and parseRequest() fills them in one
+// pass over the body, with no heap use. Unknown scalar keys are ignored;
+// nested values, fractions and escapes are rejected.
+enum ReqFieldType : uint8_t { FIELD_INT, FIELD_STR };
+
+enum ParseResult : uint8_t { PARSE_OK, PARSE_MALFORMED, PARSE_MISSING, PARSE_RANGE };
+
+#define REQ_STR_LEN 12
+
+struct ReqField {
+  const char *key;
+  ReqFieldType type;
+  bool required;
+  int32_t minVal, maxVal;   // FIELD_INT bounds
+  bool seen;
+  int32_t intVal;
+  char strVal[REQ_STR_LEN];
+};
+
+const char *skipSpace(const char *p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+  return p;
+}
+
+// Scan a quoted string; sets start/len and returns the position after it
+const char *scanString(const char *p, const char *end, const char *&start, size_t &len) {
+  if (p >= end || *p != '"') return nullptr;
+  start = ++p;
+  while (p < end && *p != '"') {
+    if (*p == '\\' || (uint8_t)*p < 0x20) return nullptr;
+    p++;
+  }
+  if (p >= end) return nullptr;
+  len = p - start;
+  return p + 1;
+}
+
+ParseResult parseRequest(const char *body, size_t bodyLen, ReqField *fields, size_t count) {
+  const char *p = body, *end = body + bodyLen;
+  for (size_t f = 0; f < count; f++) fields[f].seen = false;
+
+  p = skipSpace(p, end);
+  if (p >= end || *p++ != '{') return PARSE_MALFORMED;
+  p = skipSpace(p, end);
+  bool first = true;
+
+  while (p < end && *p != '}') {
+    if (!first) {
+      if (*p++ != ',') return PARSE_MALFORMED;
+      p = skipSpace(p, end);
+    }
+    first = false;
+
+    const char *key;
+    size_t keyLen;
+    p = scanString(p, end, key, keyLen);
+    if (!p) return PARSE_MALFORMED;
+    p = skipSpace(p, end);
+    if (p >= end || *p++ != ':') return PARSE_MALFORMED;
+    p = skipSpace(p, end);
+    if (p >= end) return PARSE_MALFORMED;
+
+    ReqField *field = nullptr;
+    for (size_t f = 0; f < count; f++) {
+      if (strlen(fields[f].key) == keyLen && memcmp(fields[f].key, key, keyLen) == 0) {
+        field = &fields[f];
+        break;
+      }
+    }
+
+    if (*p == '"') {
+      const char *str;
+      size_t strLen;
+      p = scanString(p, end, str, strLen);
+      if (!p) return PARSE_MALFORMED;
+      if (field) {
+        if (field->type != FIELD_STR) return PARSE_MALFORMED;
+        if (strLen >= REQ_STR_LEN) return PARSE_RANGE;
+        memcpy(field->strVal, str, strLen);
+        field->strVal[strLen] = '\0';
+        field->seen = true;
+      }
+    } else if (*p == '-' || (*p >= '0' && *p <= '9')) {
+      bool negative = *p == '-';
+      if (negative) p++;
+      if (p >= end || *p < '0' || *p > '9') return PARSE_MALFORMED;
+      int64_t value = 0;
+      while (p < end && *p >= '0' && *p <= '9') {
+        value = value * 10 + (*p++ - '0');
+        if (value > INT32_MAX) return PARSE_RANGE;
+      }
+      if (p < end && (*p == '.' || *p == 'e' || *p == 'E')) return PARSE_MALFORMED;
+      if (field) {
+        if (field->type != FIELD_INT) return PARSE_MALFORMED;
+        field->intVal = negative ? -value : value;
+        field->seen = true;
+      }
+    } else if (!field && end - p >= 4 && (memcmp(p, "true", 4) == 0 || memcmp(p, "null", 4) == 0)) {
+      p += 4;
+    } else if (!field && end - p >= 5 && memcmp(p, "false", 5) == 0) {
+      p += 5;
+    } else {
+      return PARSE_MALFORMED;
+    }
+    p = skipSpace(p, end);
+  }
+
+  if (p >= end) return PARSE_MALFORMED;
+  p = skipSpace(p + 1, end);
+  if (p != end) return PARSE_MALFORMED;
+
+  for (size_t f = 0; f < count; f++) {
+    if (!fields[f].seen) {
+      if (fields[f].required) return PARSE_MISSING;
+      continue;
+    }
+    if (fields[f].type == FIELD_INT &&
+        (fields[f].intVal < fields[f].minVal || fields[f].intVal > fields[f].maxVal)) {
+      return PARSE_RANGE;
+    }
+  }
+  return PARSE_OK;
+}
+
+// Names of stored sequences and poses: letters, digits, '_' and '-'
+bool validName(const char *name) {
+  if (!*name) return false;
+  for (const char *c = name; *c; c++) {
+    if (!isalnum((unsigned char)*c) && *c != '_' && *c != '-') return false;
+  }
+  return true;
+}
+
+// Request bodies are collected per request into a buffer of at most
+// REQ_BODY_MAX bytes, freed by the server with the request
+#define REQ_BODY_MAX 512
+
+void apiCollectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total) {
+  if (total > REQ_BODY_MAX) return;  // parseBody rejects it
+  if (index == 0) request->_tempObject = malloc(total + 1);
+  char *body = (char *)request->_tempObject;
+  if (!body || index + len > total) return;
+  memcpy(body + index, data, len);
+  body[index + len] = '\0';
+}
+
+typedef void (*ApiHandler)(AsyncWebServerRequest *request);
+
+// Register an endpoint whose handler runs under apiLock
+void apiOn(const char *path, WebRequestMethodComposite method, ApiHandler handler) {
+  server.on(path, method, [handler](AsyncWebServerRequest *request) {
+    ApiGuard guard;
+    if (!guard.locked) {
+      request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Busy\"}");
+      return;
+    }
+    handler(request);
+  }, nullptr, apiCollectBody);
+}
+
+// Parse the POST body into fields, replying with a 400 on failure
+bool parseBody(AsyncWebServerRequest *request, ReqField *fields, size_t count, const char *invalidMsg) {
+  if (request->contentLength() > REQ_BODY_MAX) {
+    request->send(413, "application/json", "{\"status\":\"error\",\"message\":\"Body too large\"}");
+    return false;
+  }
+  const char *body = (const char *)request->_tempObject;
+  if (!body) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"No data received\"}");
+    return false;
+  }
+
+  ParseResult result = parseRequest(body, strlen(body), fields, count);
+  if (result == PARSE_OK) return true;
+
+  respBegin();
+  respRaw("{\"status\":\"error\",\"message\":\"");
+  respRaw(result == PARSE_MALFORMED ? "Malformed JSON" : invalidMsg);
+  respRaw("\"}");
+  respSend(request, 400);
+  return false;
+}
+
+// Handle root request: serve the precompressed dashboard, or a 304 when the
+// browser already holds the current build
+void handleRoot(AsyncWebServerRequest *request) {
+  AsyncWebServerResponse *response;
+  if (request->hasHeader("If-None-Match") &&
+      request->getHeader("If-None-Match")->value() == DASHBOARD_ETAG) {
+    response = request->beginResponse(304);
+  } else {
+    response = request->beginResponse_P(200, "text/html", dashboard_html_gz, dashboard_html_gz_len);
+    response->addHeader("Content-Encoding", "gzip");
+  }
+  response->addHeader("ETag", DASHBOARD_ETAG);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+// Reply to a pose move with the target positions so the UI can sync
+void sendPoseAction(AsyncWebServerRequest *request, const char *action, uint16_t job) {
+  if (job == 0) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+  respBegin();
+  respRaw("{\"status\":\"success\",\"action\":\"");
+  respRaw(action);
+  respRaw("\",\"job\":");
+  respUInt(job);
+  respRaw(",");
+  respPositions(motionTarget);
+  respRaw("}");
+  respSend(request, 200);
+}
+
+// Handle release: stop all motion and switch every servo output off, so the
+// legs go limp. The next joint command drives them again.
+void handleRelease(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+  if (!cmdSimple(CMD_RELEASE)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+  request->send(200, "application/json", "{\"status\":\"success\",\"action\":\"release\"}");
+}
+
+void handleStand(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+
+  sendPoseAction(request, "stand", poseMove(builtinPoses[POSE_STAND], POSE_MOVE_MS));
+}
+
+void handleSit(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+
+  sendPoseAction(request, "sit", poseMove(builtinPoses[POSE_SIT], POSE_MOVE_MS));
+}
+
+void respPoseNames(const NamedPose *poses, int count) {
+  bool first = true;
+  respRaw("[");
+  for (int i = 0; i < count; i++) {
+    if (!poses[i].name[0]) continue;
+    if (!first) respRaw(",");
+    respRaw("\"");
+    respRaw(poses[i].name);
+    respRaw("\"");
+    first = false;
+  }
+  respRaw("]");
+}
+
+// GET /pose lists the library; GET or POST /pose/<name>?duration=ms moves
+// to a pose
+void handlePose(AsyncWebServerRequest *request) {
+  const String &url = request->url();
+  if (url == "/pose" || url == "/pose/") {
+    respBegin();
+    respRaw("{\"builtin\":");
+    respPoseNames(builtinPoses, POSE_BUILTIN_COUNT);
+    respRaw(",\"user\":");
+    respPoseNames(userPoses, POSE_USER_SLOTS);
+    respRaw("}");
+    respSend(request, 200);
+    return;
+  }
+
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+
+  const NamedPose *pose = nullptr;
+  if (url.length() - 6 < POSE_NAME_LEN) pose = poseFind(url.c_str() + 6);
+  if (!pose) {
+    request->send(404, "application/json", "{\"status\":\"error\",\"message\":\"No such pose\"}");
+    return;
+  }
+
+  long duration = POSE_MOVE_MS;
+  if (request->hasParam("duration")) {
+    const String &value = request->getParam("duration")->value();
+    char *end;
+    duration = strtol(value.c_str(), &end, 10);
+    if (value.length() == 0 || *end || duration < 0 || duration > POSE_MAX_MS) {
+      request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid duration\"}");
+      return;
+    }
+  }
+
+  sendPoseAction(request, pose->name, poseMove(*pose, duration));
+}
+
+// Handle pose save: {"name":"..."} stores the live pose as a user pose,
+// replacing one of the same name
+void handlePoseSave(AsyncWebServerRequest *request) {
+  ReqField field = { "name", FIELD_STR, true };
+  if (!parseBody(request, &field, 1, "Invalid name")) return;
+  if (!validName(field.strVal) || strcmp(field.strVal, "save") == 0 ||
+      strcmp(field.strVal, "delete") == 0) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid name\"}");
+    return;
+  }
+
+  const NamedPose *existing = poseFind(field.strVal);
+  if (existing >= builtinPoses && existing < builtinPoses + POSE_BUILTIN_COUNT) {
+    request->send(409, "application/json", "{\"status\":\"error\",\"message\":\"Built-in pose\"}");
+    return;
+  }
+
+  int slot = existing ? existing - userPoses : -1;
+  for (int i = 0; i < POSE_USER_SLOTS && slot < 0; i++) {
+    if (!userPoses[i].name[0]) slot = i;
+  }
+  if (slot < 0) {
+    request->send(507, "application/json", "{\"status\":\"error\",\"message\":\"Pose library full\"}");
+    return;
+  }
+
+  NamedPose &pose = userPoses[slot];
+  strlcpy(pose.name, field.strVal, sizeof(pose.name));
+  poseSnapshot(pose.angles);
+  persistPoseSlots |= 1 << slot;
+
+  respBegin();
+  respRaw("{\"status\":\"success\",\"name\":\"");
+  respRaw(pose.name);
+  respRaw("\",");
+  respAngles("positionsCdeg", pose.angles, 1);
+  respRaw("}");
+  respSend(request, 200);
+}
+
+// Handle pose delete: {"name":"..."}; built-in poses cannot be removed
+void handlePoseDelete(AsyncWebServerRequest *request) {
+  ReqField field = { "name", FIELD_STR, true };
+  if (!parseBody(request, &field, 1, "Invalid name")) return;
+
+  for (int i = 0; i < POSE_USER_SLOTS; i++) {
+    if (userPoses[i].name[0] && strcmp(userPoses[i].name, field.strVal) == 0) {
+      memset(&userPoses[i], 0, sizeof(NamedPose));
+      persistPoseSlots |= 1 << i;
+      request->send(200, "application/json", "{\"status\":\"success\"}");
+      return;
+    }
+  }
+  request->send(404, "application/json", "{\"status\":\"error\",\"message\":\"No such pose\"}");
+}
+
+// Abandon the current browser upload. The robot stays in the held pose.
+void otaFail(const char *message) {
+  Update.printError(Serial);
+  Serial.println(message);
+  otaStatus = message;
+  otaInProgress = false;
+  otaUploadOk = false;
+  mbedtls_sha256_free(&otaSha);
+}
+
+// Handle OTA update upload. The image streams into the inactive partition
+// while a SHA-256 runs over it; if the client supplied a digest (?sha256=
+// or an X-Image-SHA256 header) a mismatch aborts before the partition is
+// marked bootable.
+void handleUpdate(AsyncWebServerRequest *request, const String &filename, size_t index,
+                  uint8_t *data, size_t len, bool final) {
+  METRIC_SCOPE(METRIC_UPDATE);
+  
+  if (index == 0) {
+    Serial.printf("Update: %s\n", filename.c_str());
+    otaInProgress = true;
+    otaUploadOk = true;
+    otaStartMs = millis();
+    otaStatus = "Starting update...";
+
+    String expected;
+    if (request->hasParam("sha256")) {
+      expected = request->getParam("sha256")->value();
+    } else if (request->hasHeader("X-Image-SHA256")) {
+      expected = request->getHeader("X-Image-SHA256")->value();
+    }
+    strlcpy(otaExpectedSha, expected.c_str(), sizeof(otaExpectedSha));
+
+    // A client that goes away mid-upload leaves a partial image behind
+    request->onDisconnect([]() {
+      ApiGuard guard(portMAX_DELAY);
+      if (otaUploadOk && !otaRestartPending) {
+        Update.abort();
+        otaFail("Upload aborted");
+      }
+    });
+    
+    // Keep the robot standing still on its own instead of cutting the servos
+    otaHoldPose();
+    
+    mbedtls_sha256_init(&otaSha);
+    mbedtls_sha256_starts(&otaSha, 0);
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
+      otaFail("Update begin failed");
+    }
+  }
+
+  if (!otaUploadOk) return;
+  if (len) {
+    mbedtls_sha256_update(&otaSha, data, len);
+    if (Update.write(data, len) != len) {
+      otaFail("Update write failed");
+      return;
+    }
+    otaSetProgress(Update.progress(), Update.size());
+  }
+
+  if (final) {
+    uint8_t digest[32];
+    char hex[65];
+    mbedtls_sha256_finish(&otaSha, digest);
+    mbedtls_sha256_free(&otaSha);
+    for (int i = 0; i < 32; i++) {
+      snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+    }
+    Serial.printf("Update SHA-256: %s\n", hex);
+
+    if (otaExpectedSha[0] && strcasecmp(hex, otaExpectedSha) != 0) {
+      Update.abort();
+      otaFail("SHA-256 mismatch");
+      return;
+    }
+    if (Update.end(true)) {
+      uint32_t elapsedMs = millis() - otaStartMs;
+      Serial.printf("Update Success: %uB in %ums\n", (unsigned)(index + len), (unsigned)elapsedMs);
+      otaStatus = "Update complete - Rebooting...";
+      // Restart from loop() so the reply and status polls still go out
+      otaRestartPending = true;
+      otaRestartAtMs = millis() + 1000;
+    } else {
+      otaFail("Update end failed");
+    }
+  }
+}
+
+// Handle individual servo control
+void handleSetServo(AsyncWebServerRequest *request) {
+  METRIC_SCOPE(METRIC_SET_SERVO);
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+  
+  // "angle" is whole degrees; "cdeg" gives the full resolution
+  ReqField fields[] = {
+    { "servo", FIELD_INT, true, 0, NUM_SERVOS - 1 },
+    { "angle", FIELD_INT, false, 0, 180 },
+    { "cdeg", FIELD_INT, false, 0, CDEG_MAX },
+  };
+  if (!parseBody(request, fields, 3, "Invalid parameters")) return;
+  if (!fields[1].seen && !fields[2].seen) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid parameters\"}");
+    return;
+  }
+  
+  int servoId = fields[0].intVal;
+  int cdeg = fields[2].seen ? fields[2].intVal : CDEG(fields[1].intVal);
+  
+  uint16_t angles[NUM_SERVOS] = {};
+  angles[servoId] = cdeg;
+  if (!cmdSetJoints(1UL << servoId, angles)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+  
+  request->send(200, "application/json", "{\"status\":\"success\"}");
+  Serial.printf("Servo %d set to %d.%02d degrees\n", servoId + 1, cdeg / 100, cdeg % 100);
+}
+
+// Handle set all servos
+void handleSetAll(AsyncWebServerRequest *request) {
+  METRIC_SCOPE(METRIC_SET_ALL);
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+  
+  ReqField fields[] = {
+    { "angle", FIELD_INT, false, 0, 180 },
+    { "cdeg", FIELD_INT, false, 0, CDEG_MAX },
+  };
+  if (!parseBody(request, fields, 2, "Invalid angle")) return;
+  if (!fields[0].seen && !fields[1].seen) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid angle\"}");
+    return;
+  }
+  
+  int cdeg = fields[1].seen ? fields[1].intVal : CDEG(fields[0].intVal);
+  
+  uint16_t angles[NUM_SERVOS];
+  for (int i = 0; i < NUM_SERVOS; i++) angles[i] = cdeg;
+  if (!cmdSetJoints((1UL << NUM_SERVOS) - 1, angles)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+  
+  request->send(200, "application/json", "{\"status\":\"success\"}");
+  Serial.printf("All servos set to %d.%02d degrees\n", cdeg / 100, cdeg % 100);
+}
+
+// Handle sweep test
+void handleSweep(AsyncWebServerRequest *request) {
+  METRIC_SCOPE(METRIC_SWEEP);
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+  
+  // 19 steps up, 19 steps down, then back to center
+  if (cmdFree() < 39) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+  
+  uint16_t job = motionNewJob();
+  
+  // Sweep from 0 to 180
+  for (int angle = 0; angle <= 180; angle += 10) {
+    cmdKeyframeAll(CDEG(angle), 100, EASE_LINEAR, job);
+  }
+  
+  // Sweep back from 180 to 0
+  for (int angle = 180; angle >= 0; angle -= 10) {
+    cmdKeyframeAll(CDEG(angle), 100, EASE_LINEAR, job);
+  }
+  
+  // Return to center
+  cmdKeyframeAll(CDEG(90), 100, EASE_LINEAR, job);
+  
+  respBegin();
+  respRaw("{\"status\":\"success\",\"job\":");
+  respUInt(job);
+  respRaw("}");
+  respSend(request, 200);
+  Serial.printf("Sweep test queued as job %u\n", job);
+}
+
+// Handle get positions
+void handleGetPositions(AsyncWebServerRequest *request) {
+  respBegin();
+  respRaw("{");
+  uint16_t pose[NUM_SERVOS];
+  poseSnapshot(pose);
+  respPositions(pose);
+  respRaw(",");
+  respAngles("positionsCdeg", pose, 1);
+  respRaw(",\"otaStatus\":\"");
+  respRaw(otaStatus.c_str());
+  respRaw("\"}");
+  respSend(request, 200);
+}
+
+// UDP teleoperation protocol. Every packet is fixed-size per type and
+// little-endian:
+//   magic 'H' 'X' | version | type | seq (uint32) | payload | crc16
+// The CRC is CRC-16/CCITT-FALSE over everything before it. Packets whose
+// sequence number is not newer than the last accepted one are dropped.
+#define UDP_PORT 4210
+#define UDP_VERSION 1
+#define UDP_HEADER_LEN 8
+#define UDP_TYPE_POSE 0x01   // 18 x uint16 joint angles in cdeg
+#define UDP_TYPE_GAIT 0x02   // int16 vx, vy, turn; uint8 gait (0xFF = stop); pad
+#define UDP_TYPE_BODY 0x03   // int16 x, y, z (mm); roll, pitch, yaw (cdeg)
+#define UDP_POSE_LEN (UDP_HEADER_LEN + 2 * NUM_SERVOS + 2)
+#define UDP_GAIT_LEN (UDP_HEADER_LEN + 8 + 2)
+#define UDP_BODY_LEN (UDP_HEADER_LEN + 12 + 2)
+
+struct UdpStats {
+  uint32_t accepted;
+  uint32_t crcErrors;
+  uint32_t malformed;   // bad magic, version, type or length
+  uint32_t stale;       // duplicate or out-of-order sequence
+};
+
+UdpStats udpStats;
+uint32_t udpLastSeq = 0;
+IPAddress udpPeer;
+uint16_t udpPeerPort = 0;
+
+uint16_t crc16(const uint8_t *data, size_t len) {
+  uint16_t crc = 0xFFFF;
+  while (len--) {
+    crc ^= (uint16_t)(*data++) << 8;
+    for (int b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+uint16_t readLE16(const uint8_t *p) {
+  return p[0] | (p[1] << 8);
+}
+
+uint32_t readLE32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Six little-endian int16: x, y, z, roll, pitch, yaw
+BodyPose readBodyPose(const uint8_t *p) {
+  BodyPose b;
+  b.x = readLE16(p);
+  b.y = readLE16(p + 2);
+  b.z = readLE16(p + 4);
+  b.roll = readLE16(p + 6);
+  b.pitch = readLE16(p + 8);
+  b.yaw = readLE16(p + 10);
+  return b;
+}
+
+void udpHandlePacket(const uint8_t *pkt, size_t len) {
+  if (len < UDP_HEADER_LEN + 2 || pkt[0] != 'H' || pkt[1] != 'X' || pkt[2] != UDP_VERSION) {
+    udpStats.malformed++;
+    return;
+  }
+
+  uint8_t type = pkt[3];
+  if ((type == UDP_TYPE_POSE && len != UDP_POSE_LEN) ||
+      (type == UDP_TYPE_GAIT && len != UDP_GAIT_LEN) ||
+      (type == UDP_TYPE_BODY && len != UDP_BODY_LEN) ||
+      (type != UDP_TYPE_POSE && type != UDP_TYPE_GAIT && type != UDP_TYPE_BODY)) {
+    udpStats.malformed++;
+    return;
+  }
+
+  if (crc16(pkt, len - 2) != readLE16(pkt + len - 2)) {
+    udpStats.crcErrors++;
+    return;
+  }
+
+  // A new sender starts a new sequence; otherwise only newer packets count
+  uint32_t seq = readLE32(pkt + 4);
+  bool newPeer = !(udp.remoteIP() == udpPeer) || udp.remotePort() != udpPeerPort;
+  if (!newPeer && (int32_t)(seq - udpLastSeq) <= 0) {
+    udpStats.stale++;
+    return;
+  }
+  udpPeer = udp.remoteIP();
+  udpPeerPort = udp.remotePort();
+  udpLastSeq = seq;
+
+  const uint8_t *payload = pkt + UDP_HEADER_LEN;
+  if (type == UDP_TYPE_POSE) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      if (readLE16(payload + 2 * i) > CDEG_MAX) {
+        udpStats.malformed++;
+        return;
+      }
+    }
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      streamSetJoint(i, readLE16(payload + 2 * i));
+    }
+  } else if (type == UDP_TYPE_BODY) {
+    // Out of range or out of reach; the last pose stays in force
+    if (!bodyStream(readBodyPose(payload))) {
+      udpStats.malformed++;
+      return;
+    }
+  } else {
+    int16_t vx = readLE16(payload);
+    int16_t vy = readLE16(payload + 2);
+    int16_t turn = readLE16(payload + 4);
+    uint8_t gait = payload[6];
+    if (gait == 0xFF || gait < GAIT_COUNT) {
+      cmdGait(gait, vx, vy, turn);
+    } else {
+      udpStats.malformed++;
+      return;
+    }
+  }
+  udpStats.accepted++;
+}
+
+// Drain every pending datagram
+void udpService() {
+  uint8_t pkt[64];
+  int size;
+  while ((size = udp.parsePacket()) > 0) {
+    int len = udp.read(pkt, sizeof(pkt));
+    if (otaInProgress) continue;
+    if (size > (int)sizeof(pkt)) {
+      udpStats.malformed++;
+      continue;
+    }
+    udpHandlePacket(pkt, len);
+  }
+}
+
+// Handle motion scheduler status
+void handleMotion(AsyncWebServerRequest *request) {
+  char json[800];
+  MotionStatus st;
+  statusSnapshot(st);
+  uint32_t lateAvg = st.ticks ? st.lateSumUs / st.ticks : 0;
+  uint32_t gaitAvg = st.gaitTicks ? st.gaitSumUs / st.gaitTicks : 0;
+  uint32_t streamLatAvg = st.streamFrames ? st.streamLatSumUs / st.streamFrames : 0;
+  uint32_t cmdLatAvg = st.cmdApplied ? st.cmdLatSumUs / st.cmdApplied : 0;
+  // Share of the tick period the gait compute uses at its worst
+  uint32_t gaitBudgetPct = (st.gaitMaxUs * 100) / MOTION_TICK_US;
+  snprintf(json, sizeof(json),
+           "{\"activeJob\":%u,\"lastDoneJob\":%u,\"queued\":%u,"
+           "\"ticks\":%u,\"overruns\":%u,\"lateAvgUs\":%u,\"lateMaxUs\":%u,"
+           "\"gait\":\"%s\",\"gaitAvgUs\":%u,\"gaitMaxUs\":%u,\"gaitBudgetPct\":%u,"
+           "\"streamCommands\":%u,\"streamCoalesced\":%u,\"streamLatAvgUs\":%u,\"streamLatMaxUs\":%u,"
+           "\"udpAccepted\":%u,\"udpCrcErrors\":%u,\"udpMalformed\":%u,\"udpStale\":%u,"
+           "\"cmdPushed\":%u,\"cmdDropped\":%u,\"cmdLatAvgUs\":%u,\"cmdLatMaxUs\":%u,"
+           "\"outMoving\":%u,\"outMovingPeak\":%u,\"outCurrentMa\":%u,\"outCurrentPeakMa\":%u,"
+           "\"outDeferrals\":%u,\"pwmDigest\":\"%08x\",\"pwmFrames\":%u}",
+           st.activeJob, st.lastDoneJob, st.queued,
+           (unsigned)st.ticks, (unsigned)st.overruns,
+           (unsigned)lateAvg, (unsigned)st.lateMaxUs,
+           st.gait != 0xFF ? gaitPatterns[st.gait].name : "idle",
+           (unsigned)gaitAvg, (unsigned)st.gaitMaxUs, (unsigned)gaitBudgetPct,
+           (unsigned)streamStats.commands, (unsigned)streamStats.coalesced,
+           (unsigned)streamLatAvg, (unsigned)st.streamLatMaxUs,
+           (unsigned)udpStats.accepted, (unsigned)udpStats.crcErrors,
+           (unsigned)udpStats.malformed, (unsigned)udpStats.stale,
+           (unsigned)cmdStats.pushed, (unsigned)cmdStats.dropped,
+           (unsigned)cmdLatAvg, (unsigned)st.cmdLatMaxUs,
+           st.moving, st.movingPeak, st.currentMa, st.currentPeakMa,
+           (unsigned)st.deferrals,
+           (unsigned)st.pwmDigest, (unsigned)st.pwmFrames);
+  request->send(200, "application/json", json);
+}
+
+// Handle gait command: {"gait":"tripod|wave|ripple|stop","vx":mm/s,"vy":mm/s,"turn":cdeg/s}
+void handleGait(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+
+  ReqField fields[] = {
+    { "gait", FIELD_STR, false },
+    { "vx", FIELD_INT, false, -500, 500 },
+    { "vy", FIELD_INT, false, -500, 500 },
+    { "turn", FIELD_INT, false, -9000, 9000 },
+  };
+  if (!parseBody(request, fields, 4, "Invalid parameters")) return;
+
+  const char *name = fields[0].seen ? fields[0].strVal : "tripod";
+  int vx = fields[1].seen ? fields[1].intVal : 0;
+  int vy = fields[2].seen ? fields[2].intVal : 0;
+  int turn = fields[3].seen ? fields[3].intVal : 0;
+
+  if (strcmp(name, "stop") == 0) {
+    cmdGait(0xFF, 0, 0, 0);
+    request->send(200, "application/json", "{\"status\":\"success\",\"gait\":\"stop\"}");
+    return;
+  }
+
+  int type = 0;
+  while (type < GAIT_COUNT && strcmp(name, gaitPatterns[type].name) != 0) type++;
+  if (type == GAIT_COUNT) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid parameters\"}");
+    return;
+  }
+
+  if (cmdGait(type, vx, vy, turn)) {
+    respBegin();
+    respRaw("{\"status\":\"success\",\"gait\":\"");
+    respRaw(gaitPatterns[type].name);
+    respRaw("\"}");
+    respSend(request, 200);
+  } else {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+  }
+}
+
+// Handle body pose: {"x","y","z":mm,"roll","pitch","yaw":cdeg,"durationMs"}.
+// Missing axes are zero; the move eases in over durationMs.
+void handleBody(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
+
+  ReqField fields[] = {
+    { "x", FIELD_INT, false, -BODY_MAX_SHIFT, BODY_MAX_SHIFT },
+    { "y", FIELD_INT, false, -BODY_MAX_SHIFT, BODY_MAX_SHIFT },
+    { "z", FIELD_INT, false, -BODY_MAX_SHIFT, BODY_MAX_SHIFT },
+    { "roll", FIELD_INT, false, -BODY_MAX_TILT, BODY_MAX_TILT },
+    { "pitch", FIELD_INT, false, -BODY_MAX_TILT, BODY_MAX_TILT },
+    { "yaw", FIELD_INT, false, -BODY_MAX_YAW, BODY_MAX_YAW },
+    { "durationMs", FIELD_INT, false, 0, 5000 },
+  };
+  if (!parseBody(request, fields, 7, "Invalid parameters")) return;
+
+  BodyPose b;
+  int16_t *axes[] = { &b.x, &b.y, &b.z, &b.roll, &b.pitch, &b.yaw };
+  for (int i = 0; i < 6; i++) *axes[i] = fields[i].seen ? fields[i].intVal : 0;
+  uint16_t duration = fields[6].seen ? fields[6].intVal : BODY_MOVE_MS;
+
+  uint16_t pose[NUM_SERVOS];
+  if (!bodySolve(b, pose)) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Pose out of reach\"}");
+    return;
+  }
+
+  uint16_t job = motionNewJob();
+  if (!cmdKeyframe(pose, duration, EASE_MIN_JERK, job)) job = 0;
+  if (job) bodyPose = b;
+  sendPoseAction(request, "body", job);
+}
+
+// Handle body pose query, with solver cache statistics
+void handleGetBody(AsyncWebServerRequest *request) {
+  uint32_t legs = bodyStats.legHits + bodyStats.legSolves;
+  uint32_t hitPct = legs ? (uint64_t)bodyStats.legHits * 100 / legs : 0;
+  char json[320];
+  snprintf(json, sizeof(json),
+           "{\"x\":%d,\"y\":%d,\"z\":%d,\"roll\":%d,\"pitch\":%d,\"yaw\":%d,"
+           "\"poses\":%u,\"rejected\":%u,\"legHits\":%u,\"legSolves\":%u,"
+           "\"hitPct\":%u,\"solveLastUs\":%u,\"solveMaxUs\":%u}",
+           bodyPose.x, bodyPose.y, bodyPose.z, bodyPose.roll, bodyPose.pitch, bodyPose.yaw,
+           (unsigned)bodyStats.poses, (unsigned)bodyStats.rejected,
+           (unsigned)bodyStats.legHits, (unsigned)bodyStats.legSolves, (unsigned)hitPct,
+           (unsigned)bodyStats.lastUs, (unsigned)bodyStats.maxUs);
+  request->send(200, "application/json", json);
+}
+
+// WebSocket control channel. Binary frames, angles in whole degrees or
+// little-endian uint16 cdeg:
+//   [0x01, servo, angle]             one joint
+//   [0x02, angle0 .. angle17]        full 18-joint frame
+//   [0x03, servo, cdeg]              one joint, fine
+//   [0x04, cdeg0 .. cdeg17]          full 18-joint frame, fine
+//   [0x05, x, y, z, roll, pitch, yaw] body pose, int16 mm and cdeg
+// The server pushes telemetry to every client as JSON text frames.
+#define WS_CMD_SERVO 0x01
+#define WS_CMD_FRAME 0x02
+#define WS_CMD_SERVO_CDEG 0x03
+#define WS_CMD_FRAME_CDEG 0x04
+#define WS_CMD_BODY 0x05
+
+void onWebSocketEvent(uint8_t client, WStype_t type, uint8_t *payload, size_t length) {
+  if (type != WStype_BIN || length == 0 || otaInProgress) return;
+
+  if (payload[0] == WS_CMD_SERVO && length == 3) {
+    if (payload[1] < NUM_SERVOS && payload[2] <= 180) {
+      streamSetJoint(payload[1], CDEG(payload[2]));
+    }
+  } else if (payload[0] == WS_CMD_FRAME && length == 1 + NUM_SERVOS) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      if (payload[1 + i] > 180) return;
+    }
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      streamSetJoint(i, CDEG(payload[1 + i]));
+    }
+  } else if (payload[0] == WS_CMD_SERVO_CDEG && length == 4) {
+    if (payload[1] < NUM_SERVOS && readLE16(payload + 2) <= CDEG_MAX) {
+      streamSetJoint(payload[1], readLE16(payload + 2));
+    }
+  } else if (payload[0] == WS_CMD_FRAME_CDEG && length == 1 + 2 * NUM_SERVOS) {
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      if (readLE16(payload + 1 + 2 * i) > CDEG_MAX) return;
+    }
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      streamSetJoint(i, readLE16(payload + 1 + 2 * i));
+    }
+  } else if (payload[0] == WS_CMD_BODY && length == 1 + 12) {
+    bodyStream(readBodyPose(payload + 1));
+  }
+}
+
+// Motion sequences are stored in LittleFS as /seq/<name>.hxr:
+//   'H' 'X' 'R' version
+//   frames: varint dtTicks | varint jointMask | zigzag varint delta per joint
+// Each frame lists only the joints that moved, as a cdeg delta from the
+// previous frame; the first frame is relative to all zeros. Idle stretches
+// are written as frames with an empty mask, so a file replays at the tick
+// rate it was captured at. Playback reads one frame at a time and queues it
+// as a linear keyframe, a short lookahead ahead of the tick.
+#define SEQ_VERSION 1
+#define SEQ_MAX_DT_TICKS (60000 / MOTION_TICK_MS)  // keyframe durationMs limit
+#define SEQ_LOOKAHEAD_MS 200
+#define SEQ_RING_RESERVE 8      // ring slots left for other commands
+#define SEQ_LIST_MAX 16
+
+// Handlers never write to the partition: creating, finishing and removing
+// files, and the directory walk, happen in seqService() from loop().
+// SEQ_STOPPING is a recording whose last frames are still being written.
+enum SeqState : uint8_t { SEQ_IDLE, SEQ_RECORDING, SEQ_PLAYING, SEQ_STOPPING };
+enum SeqRead : uint8_t { SEQ_FRAME, SEQ_END, SEQ_CORRUPT };
+
+const char *const seqStateNames[] = { "idle", "recording", "playing", "stopping" };
+
+struct SeqEntry {
+  char name[REQ_STR_LEN];
+  uint32_t bytes;
+};
+
+SeqState seqState = SEQ_IDLE;
+File seqFile;
+char seqName[REQ_STR_LEN] = "";
+const char *seqResult = "none";   // outcome of the last sequence
+uint16_t seqPose[NUM_SERVOS];     // last frame written or read (cdeg)
+bool seqCreatePending = false;    // seqPose holds the start pose until then
+uint32_t seqTick = 0;             // tick of the last recorded frame
+bool seqTickSet = false;          // seqTick taken from a captured frame yet
+uint32_t seqFrames = 0;
+uint32_t seqBytes = 0;
+uint16_t seqJob = 0;
+uint32_t seqStartMs = 0;
+uint32_t seqQueuedMs = 0;         // playback time already handed to the tick
+
+SeqEntry seqList[SEQ_LIST_MAX];   // directory as of the last scan
+uint8_t seqListCount = 0;
+bool seqListFull = false;         // more files than seqList holds
+bool seqListDirty = true;
+SeqEntry seqRemoving[SEQ_LIST_MAX];  // deleted, file not removed yet
+uint8_t seqRemoveCount = 0;
+
+void seqPath(char *path, size_t len, const char *name) {
+  snprintf(path, len, "/seq/%.*s.hxr", REQ_STR_LEN - 1, name);
+}
+
+size_t putVarint(uint8_t *p, uint32_t value) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    p[n++] = value | 0x80;
+    value >>= 7;
+  }
+  p[n++] = value;
+  return n;
+}
+
+bool seqReadVarint(uint32_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    int b = seqFile.read();
+    if (b < 0) return false;
+    value |= (uint32_t)(b & 0x7F) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+// Encode pose against seqPose and append it. Returns false on a short
+// write, which means the partition is full.
+bool seqWriteFrame(uint32_t dtTicks, const uint16_t *pose) {
+  uint8_t buf[5 + 3 + 3 * NUM_SERVOS];
+  uint32_t mask = 0;
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (pose[i] != seqPose[i]) mask |= (1UL << i);
+  }
+
+  size_t n = putVarint(buf, dtTicks);
+  n += putVarint(buf + n, mask);
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (!(mask & (1UL << i))) continue;
+    int32_t delta = (int32_t)pose[i] - seqPose[i];
+    n += putVarint(buf + n, ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31));
+    seqPose[i] = pose[i];
+  }
+
+  if (seqFile.write(buf, n) != n) return false;
+  seqBytes += n;
+  seqFrames++;
+  return true;
+}
+
+// Decode the next frame into seqPose
+SeqRead seqReadFrame(uint32_t &dtTicks) {
+  uint32_t mask;
+  int first = seqFile.read();
+  if (first < 0) return SEQ_END;
+  dtTicks = first & 0x7F;
+  if (first & 0x80) {
+    uint32_t rest;
+    if (!seqReadVarint(rest)) return SEQ_CORRUPT;
+    dtTicks |= rest << 7;
+  }
+  if (dtTicks > SEQ_MAX_DT_TICKS || !seqReadVarint(mask) || (mask >> NUM_SERVOS)) return SEQ_CORRUPT;
+
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (!(mask & (1UL << i))) continue;
+    uint32_t zz;
+    if (!seqReadVarint(zz)) return SEQ_CORRUPT;
+    int32_t angle = seqPose[i] + (int32_t)((zz >> 1) ^ -(zz & 1));
+    if (angle < 0 || angle > CDEG_MAX) return SEQ_CORRUPT;
+    seqPose[i] = angle;
+  }
+  seqFrames++;
+  return SEQ_FRAME;
+}
+
+// Start capturing; the file is created by seqService()
+void seqStartRecording(const char *name) {
+  strlcpy(seqName, name, sizeof(seqName));
+  seqBytes = 0;
+  seqFrames = 0;
+  recDropped.store(0, std::memory_order_relaxed);
+
+  // The first frame is the pose at the start; then capture from the tick
+  poseSnapshot(seqPose);
+  seqCreatePending = true;
+  recHead.store(recTail.load(std::memory_order_acquire), std::memory_order_relaxed);
+  // The motion tick may be between counting a tick and capturing it, so
+  // the tick count is not read here; the first captured frame sets it
+  seqTickSet = false;
+  recActive.store(true, std::memory_order_release);
+  seqState = SEQ_RECORDING;
+}
+
+// Write the header and the start pose
+bool seqCreateFile() {
+  char path[32];
+  seqPath(path, sizeof(path), seqName);
+  seqFile = LittleFS.open(path, "w");
+  if (!seqFile) return false;
+
+  const uint8_t header[4] = { 'H', 'X', 'R', SEQ_VERSION };
+  if (seqFile.write(header, sizeof(header)) != sizeof(header)) return false;
+  seqBytes = sizeof(header);
+
+  uint16_t start[NUM_SERVOS];
+  memcpy(start, seqPose, sizeof(start));
+  memset(seqPose, 0, sizeof(seqPose));
+  return seqWriteFrame(0, start);
+}
+
+bool seqStartPlayback(const char *name) {
+  char path[32];
+  seqPath(path, sizeof(path), name);
+  seqFile = LittleFS.open(path, "r");
+  if (!seqFile) return false;
+
+  uint8_t header[4];
+  for (int i = 0; i < 4; i++) header[i] = seqFile.read();
+  if (header[0] != 'H' || header[1] != 'X' || header[2] != 'R' || header[3] != SEQ_VERSION) {
+    seqFile.close();
+    seqResult = "corrupt";
+    return false;
+  }
+
+  strlcpy(seqName, name, sizeof(seqName));
+  memset(seqPose, 0, sizeof(seqPose));
+  seqBytes = seqFile.size();
+  seqFrames = 0;
+  seqJob = motionNewJob();
+  seqStartMs = millis();
+  seqQueuedMs = 0;
+  seqState = SEQ_PLAYING;
+  // Fingerprint the replay from its first keyframe on
+  cmdSimple(CMD_DIGEST_RESET);
+  return true;
+}
+
+void seqStop(const char *result) {
+  if (seqState == SEQ_RECORDING || seqState == SEQ_STOPPING) {
+    recActive.store(false, std::memory_order_relaxed);
+    seqCreatePending = false;
+    seqListDirty = true;
+  }
+  if (seqState != SEQ_IDLE) {
+    if (seqFile) seqFile.close();
+    seqResult = result;
+  }
+  seqState = SEQ_IDLE;
+}
+
+// Drain captured frames into the file. Flash writes briefly stall both
+// cores; the motion task absorbs that as a late tick.
+void seqRecordService() {
+  if (seqCreatePending) {
+    seqCreatePending = false;
+    if (!seqCreateFile()) {
+      seqStop("error");
+      return;
+    }
+  }
+
+  uint32_t head = recHead.load(std::memory_order_relaxed);
+  while (head != recTail.load(std::memory_order_acquire)) {
+    const RecFrame &frame = recRing[head & (REC_RING_LEN - 1)];
+    if (!seqTickSet) {
+      // The first captured frame directly follows the start pose
+      seqTick = frame.tick - 1;
+      seqTickSet = true;
+    }
+    if (memcmp(frame.angles, seqPose, sizeof(seqPose)) != 0) {
+      // Hold the previous pose through any idle ticks, then step
+      uint32_t idle = (int32_t)(frame.tick - seqTick) > 1 ? frame.tick - seqTick - 1 : 0;
+      bool written = true;
+      while (idle && written) {
+        uint32_t dt = idle < SEQ_MAX_DT_TICKS ? idle : SEQ_MAX_DT_TICKS;
+        written = seqWriteFrame(dt, seqPose);
+        idle -= dt;
+      }
+      if (!written || !seqWriteFrame(1, frame.angles)) {
+        seqStop("full");
+        return;
+      }
+      seqTick = frame.tick;
+    }
+    recHead.store(++head, std::memory_order_release);
+  }
+}
+
+// Queue frames as keyframes until the lookahead is covered
+void seqPlayService() {
+  uint32_t horizon = millis() - seqStartMs + SEQ_LOOKAHEAD_MS;
+  while (seqQueuedMs < horizon && cmdFree() > SEQ_RING_RESERVE) {
+    uint32_t dtTicks;
+    SeqRead result = seqReadFrame(dtTicks);
+    if (result != SEQ_FRAME) {
+      seqStop(result == SEQ_END ? "done" : "corrupt");
+      return;
+    }
+
+    // Ease into the first frame from wherever the robot is
+    bool first = seqFrames == 1;
+    uint16_t durationMs = first ? POSE_MOVE_MS : dtTicks * MOTION_TICK_MS;
+    cmdKeyframe(seqPose, durationMs, first ? EASE_MIN_JERK : EASE_LINEAR, seqJob);
+    seqQueuedMs += durationMs;
+  }
 }
 
-// Initialize all servos to center position
-void initServos() {
-  for (int i = 0; i < NUM_SERVOS; i++) {
-    servoPositions[i] = 90;  // Center position
-    pwm.setPWM(i, 0, angleToPWM(90));
+bool seqRemovePending(const char *name) {
+  for (int i = 0; i < seqRemoveCount; i++) {
+    if (strcmp(seqRemoving[i].name, name) == 0) return true;
   }
-  delay(500);
+  return false;
 }
 
-// Setup OTA
-void setupOTA() {
-  // Port defaults to 3232
-  ArduinoOTA.setPort(3232);
+// Remove the files handlers deleted, before a recording under the same
+// name is created again
+void seqRemoveService() {
+  for (int i = 0; i < seqRemoveCount; i++) {
+    char path[32];
+    seqPath(path, sizeof(path), seqRemoving[i].name);
+    LittleFS.remove(path);
+  }
+  seqRemoveCount = 0;
+  seqListDirty = true;
+}
 
-  // Hostname defaults to esp32-[MAC]
-  ArduinoOTA.setHostname("ESP32-ServoController");
+void seqListScan() {
+  seqListCount = 0;
+  seqListFull = false;
+  File dir = LittleFS.open("/seq");
+  for (File f = dir.openNextFile(); f; f = dir.openNextFile()) {
+    const char *base = strrchr(f.name(), '/');
+    base = base ? base + 1 : f.name();
+    const char *ext = strrchr(base, '.');
+    if (f.isDirectory() || !ext || strcmp(ext, ".hxr") != 0) continue;
+    if (seqListCount == SEQ_LIST_MAX) {
+      seqListFull = true;
+      break;
+    }
 
-  // Set password for OTA updates (optional but recommended)
-  ArduinoOTA.setPassword("servo123");
+    SeqEntry &entry = seqList[seqListCount++];
+    size_t len = ext - base < REQ_STR_LEN - 1 ? ext - base : REQ_STR_LEN - 1;
+    memcpy(entry.name, base, len);
+    entry.name[len] = '\0';
+    entry.bytes = f.size();
+  }
+  seqListDirty = false;
+}
 
-  ArduinoOTA.onStart([]() {
-    String type;
-    if (ArduinoOTA.getCommand() == U_FLASH)
-      type = "sketch";
-    else // U_SPIFFS
-      type = "filesystem";
+void seqService() {
+  if (seqRemoveCount) seqRemoveService();
 
-    otaInProgress = true;
-    otaStatus = "Starting " + type + " update...";
-    Serial.println("Start updating " + type);
-    
-    // Stop servo operations during update
-    for (int i = 0; i < NUM_SERVOS; i++) {
-      pwm.setPWM(i, 0, 0); // Turn off all servos
-    }
-  });
+  // A firmware update owns both the pose and the flash
+  if (otaInProgress && seqState != SEQ_IDLE) {
+    seqStop("interrupted");
+  } else if (seqState == SEQ_RECORDING) {
+    seqRecordService();
+  } else if (seqState == SEQ_STOPPING) {
+    seqRecordService();
+    if (seqState == SEQ_STOPPING) seqStop("stopped");
+  } else if (seqState == SEQ_PLAYING) {
+    seqPlayService();
+  }
 
-  ArduinoOTA.onEnd([]() {
-    otaInProgress = false;
-    otaStatus = "Update Complete - Rebooting...";
-    Serial.println("\nEnd");
-  });
+  if (seqListDirty && !otaInProgress) seqListScan();
+}
 
-  ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
-    unsigned int percent = (progress / (total / 100));
-    otaStatus = "Progress: " + String(percent) + "%";
-    Serial.printf("Progress: %u%%\r", percent);
-  });
+// Reply with the sequence state; with listing, include the stored files
+void sendSequenceStatus(AsyncWebServerRequest *request, bool listing) {
+  MotionStatus st;
+  statusSnapshot(st);
+  respBegin();
+  respRaw("{\"status\":\"success\",\"state\":\"");
+  respRaw(seqStateNames[seqState]);
+  respRaw("\",\"name\":\"");
+  respRaw(seqName);
+  respRaw("\",\"result\":\"");
+  respRaw(seqResult);
+  respRaw("\",\"frames\":");
+  respUInt(seqFrames);
+  respRaw(",\"bytes\":");
+  respUInt(seqBytes);
+  respRaw(",\"rawBytes\":");
+  respUInt(seqFrames * sizeof(RecFrame));
+  respRaw(",\"dropped\":");
+  respUInt(recDropped.load(std::memory_order_relaxed));
+  char digest[12];
+  snprintf(digest, sizeof(digest), "%08x", (unsigned)st.pwmDigest);
+  respRaw(",\"pwmDigest\":\"");
+  respRaw(digest);
+  respRaw("\",\"pwmFrames\":");
+  respUInt(st.pwmFrames);
+  if (seqState == SEQ_PLAYING) {
+    respRaw(",\"job\":");
+    respUInt(seqJob);
+  }
 
-  ArduinoOTA.onError([](ota_error_t error) {
-    otaInProgress = false;
-    Serial.printf("Error[%u]: ", error);
-    if (error == OTA_AUTH_ERROR) {
-      otaStatus = "Auth Failed";
-      Serial.println("Auth Failed");
-    } else if (error == OTA_BEGIN_ERROR) {
-      otaStatus = "Begin Failed";
-      Serial.println("Begin Failed");
-    } else if (error == OTA_CONNECT_ERROR) {
-      otaStatus = "Connect Failed";
-      Serial.println("Connect Failed");
-    } else if (error == OTA_RECEIVE_ERROR) {
-      otaStatus = "Receive Failed";
-      Serial.println("Receive Failed");
-    } else if (error == OTA_END_ERROR) {
-      otaStatus = "End Failed";
-      Serial.println("End Failed");
+  if (listing) {
+    respRaw(",\"files\":[");
+    int listed = 0;
+    for (int i = 0; i < seqListCount; i++) {
+      const SeqEntry &entry = seqList[i];
+      if (seqRemovePending(entry.name)) continue;
+      respRaw(listed++ ? ",{\"name\":\"" : "{\"name\":\"");
+      respRaw(entry.name);
+      respRaw("\",\"bytes\":");
+      respUInt(entry.bytes);
+      respRaw("}");
     }
-    
-    // Reinitialize servos after failed update
-    initServos();
-  });
-
-  ArduinoOTA.begin();
-  Serial.println("OTA Ready");
-  Serial.print("IP address: ");
-  Serial.println(WiFi.localIP());
+    respRaw("]");
+  }
+  respRaw("}");
+  respSend(request, 200);
 }
 
-// HTML Dashboard with OTA functionality
-const char* dashboard_html = R"rawliteral(
-<!DOCTYPE html>
-<html lang="en">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>ESP32 Servo Controller</title>
-    <style>
-        * {
-            margin: 0;
-            padding: 0;
-            box-sizing: border-box;
-        }
-        
-        body {
-            font-family: 'Segoe UI', Tahoma, Geneva, Verdana, sans-serif;
-            background: linear-gradient(135deg, #667eea 0%, #764ba2 100%);
-            min-height: 100vh;
-            padding: 20px;
-        }
-        
-        .container {
-            max-width: 1200px;
-            margin: 0 auto;
-            background: rgba(255, 255, 255, 0.95);
-            border-radius: 15px;
-            box-shadow: 0 20px 40px rgba(0,0,0,0.1);
-            overflow: hidden;
-        }
-        
-        .header {
-            background: linear-gradient(45deg, #667eea, #764ba2);
-            color: white;
-            padding: 30px;
-            text-align: center;
-        }
-        
-        .header h1 {
-            font-size: 2.5em;
-            margin-bottom: 10px;
-        }
-        
-        .status {
-            display: inline-block;
-            background: rgba(255,255,255,0.2);
-            padding: 5px 15px;
-            border-radius: 20px;
-            font-size: 0.9em;
-        }
-        
-        .controls {
-            padding: 30px;
-        }
-        
-        .ota-section {
-            background: #f8f9fa;
-            border-radius: 10px;
-            padding: 20px;
-            margin-bottom: 30px;
-            border: 2px solid #e9ecef;
-        }
-        
-        .ota-section h3 {
-            color: #667eea;
-            margin-bottom: 15px;
-        }
-        
-        .ota-upload {
-            display: flex;
-            gap: 10px;
-            align-items: center;
-            flex-wrap: wrap;
-        }
-        
-        .file-input {
-            flex: 1;
-            min-width: 200px;
-            padding: 10px;
-            border: 2px solid #ddd;
-            border-radius: 5px;
-            font-size: 14px;
-        }
-        
-        .ota-status {
-            padding: 10px;
-            border-radius: 5px;
-            margin-top: 10px;
-            font-weight: bold;
-            text-align: center;
-        }
-        
-        .ota-ready { background: #d4edda; color: #155724; }
-        .ota-progress { background: #d1ecf1; color: #0c5460; }
-        .ota-error { background: #f8d7da; color: #721c24; }
-        .ota-success { background: #d4edda; color: #155724; }
-        
-        .control-panel {
-            display: grid;
-            grid-template-columns: repeat(auto-fit, minmax(350px, 1fr));
-            gap: 20px;
-            margin-bottom: 30px;
-        }
-        
-        .servo-group {
-            background: #f8f9fa;
-            border-radius: 10px;
-            padding: 20px;
-            border: 2px solid #e9ecef;
-            transition: transform 0.2s ease;
-        }
-        
-        .servo-group:hover {
-            transform: translateY(-2px);
-            box-shadow: 0 5px 15px rgba(0,0,0,0.1);
-        }
-        
-        .servo-control {
-            margin-bottom: 15px;
-        }
-        
-        .servo-label {
-            display: flex;
-            justify-content: space-between;
-            align-items: center;
-            margin-bottom: 8px;
-            font-weight: 600;
-            color: #495057;
-        }
-        
-        .servo-value {
-            background: #667eea;
-            color: white;
-            padding: 2px 8px;
-            border-radius: 12px;
-            font-size: 0.85em;
-            min-width: 40px;
-            text-align: center;
-        }
-        
-        .servo-slider {
-            width: 100%;
-            height: 6px;
-            border-radius: 3px;
-            background: #ddd;
-            outline: none;
-            -webkit-appearance: none;
-            cursor: pointer;
-            transition: background 0.3s ease;
-        }
-        
-        .servo-slider::-webkit-slider-thumb {
-            -webkit-appearance: none;
-            appearance: none;
-            width: 20px;
-            height: 20px;
-            border-radius: 50%;
-            background: #667eea;
-            cursor: pointer;
-            box-shadow: 0 2px 4px rgba(0,0,0,0.2);
-            transition: all 0.2s ease;
-        }
-        
-        .servo-slider::-webkit-slider-thumb:hover {
-            background: #5a6fd8;
-            transform: scale(1.1);
-        }
-        
-        .servo-slider::-moz-range-thumb {
-            width: 20px;
-            height: 20px;
-            border-radius: 50%;
-            background: #667eea;
-            cursor: pointer;
-            border: none;
-            box-shadow: 0 2px 4px rgba(0,0,0,0.2);
-        }
-        
-        .quick-actions {
-            display: flex;
-            gap: 10px;
-            flex-wrap: wrap;
-            justify-content: center;
-            margin-top: 20px;
-            padding-top: 20px;
-            border-top: 2px solid #e9ecef;
-        }
-        
-        .btn {
-            padding: 12px 24px;
-            border: none;
-            border-radius: 25px;
-            font-size: 16px;
-            font-weight: 600;
-            cursor: pointer;
-            transition: all 0.3s ease;
-            box-shadow: 0 4px 15px rgba(0,0,0,0.1);
-        }
-        
-        .btn-primary {
-            background: linear-gradient(45deg, #667eea, #764ba2);
-            color: white;
-        }
-        
-        .btn-secondary {
-            background: #6c757d;
-            color: white;
-        }
-        
-        .btn-success {
-            background: #28a745;
-            color: white;
-        }
-        
-        .btn-warning {
-            background: #ffc107;
-            color: #212529;
-        }
-        
-        .btn:hover {
-            transform: translateY(-2px);
-            box-shadow: 0 6px 20px rgba(0,0,0,0.15);
-        }
-        
-        .btn:disabled {
-            opacity: 0.6;
-            cursor: not-allowed;
-            transform: none;
-        }
-        
-        .connection-status {
-            position: fixed;
-            top: 20px;
-            right: 20px;
-            padding: 10px 20px;
-            border-radius: 20px;
-            color: white;
-            font-weight: bold;
-            z-index: 1000;
-            transition: all 0.3s ease;
-        }
-        
-        .connected {
-            background: #28a745;
-        }
-        
-        .disconnected {
-            background: #dc3545;
-        }
-        
-        @media (max-width: 768px) {
-            .control-panel {
-                grid-template-columns: 1fr;
-            }
-            
-            .header h1 {
-                font-size: 2em;
-            }
-            
-            .quick-actions {
-                flex-direction: column;
-            }
-            
-            .ota-upload {
-                flex-direction: column;
-            }
-        }
-    </style>
-</head>
-<body>
-    <div id="connectionStatus" class="connection-status connected">Connected</div>
-    
-    <div class="container">
-        <div class="header">
-            <h1>🎛️ ESP32 Servo Controller</h1>
-            <div class="status">18 Channel PCA9685 Controller with OTA</div>
-        </div>
-        
-        <div class="controls">
-            <!-- OTA Update Section -->
-            <div class="ota-section">
-                <h3>🔄 Firmware Update (OTA)</h3>
-                <div class="ota-upload">
-                    <input type="file" id="firmwareFile" class="file-input" accept=".bin" />
-                    <button class="btn btn-warning" onclick="uploadFirmware()" id="uploadBtn">Upload Firmware</button>
-                </div>
-                <div id="otaStatus" class="ota-status ota-ready">Ready for firmware update</div>
-                <small style="color: #6c757d; display: block; margin-top: 10px;">
-                    Select a .bin file compiled for ESP32. Device will reboot automatically after successful update.
-                </small>
-            </div>
-            
-            <div class="control-panel">
-                <div class="servo-group">
-                    <h3 style="margin-bottom: 15px; color: #667eea;">Servos 1-6</h3>
-                    <div id="servos-0-5"></div>
-                </div>
-                
-                <div class="servo-group">
-                    <h3 style="margin-bottom: 15px; color: #667eea;">Servos 7-12</h3>
-                    <div id="servos-6-11"></div>
-                </div>
-                
-                <div class="servo-group">
-                    <h3 style="margin-bottom: 15px; color: #667eea;">Servos 13-18</h3>
-                    <div id="servos-12-17"></div>
-                </div>
-            </div>
-            
-            <div class="quick-actions">
-                <button class="btn btn-primary" onclick="setAllServos(90)">Center All</button>
-                <button class="btn btn-secondary" onclick="setAllServos(0)">Min Position</button>
-                <button class="btn btn-secondary" onclick="setAllServos(180)">Max Position</button>
-                <button class="btn btn-success" onclick="sweepAll()">Sweep Test</button>
-                <button class="btn btn-primary" onclick="getPositions()">Refresh</button>
-            </div>
-
-          <button class="btn btn-warning" onclick="standUp()">Stand Up</button>
-          <button class="btn btn-warning" onclick="sitDown()">Sit Down</button>
-
-        </div>
-    </div>
-
-    <script>
-        let servos = {};
-        let sweeping = false;
-        
-        // Initialize servo controls
-        function initControls() {
-            const groups = [
-                { container: 'servos-0-5', start: 0, end: 5 },
-                { container: 'servos-6-11', start: 6, end: 11 },
-                { container: 'servos-12-17', start: 12, end: 17 }
-            ];
-            
-            groups.forEach(group => {
-                const container = document.getElementById(group.container);
-                for (let i = group.start; i <= group.end; i++) {
-                    const servoDiv = document.createElement('div');
-                    servoDiv.className = 'servo-control';
-                    servoDiv.innerHTML = `
-                        <div class="servo-label">
-                            <span>Servo ${i + 1}</span>
-                            <span class="servo-value" id="value-${i}">90°</span>
-                        </div>
-                        <input type="range" class="servo-slider" id="servo-${i}" 
-                               min="0" max="180" value="90" 
-                               oninput="updateServo(${i}, this.value)">
-                    `;
-                    container.appendChild(servoDiv);
-                    servos[i] = 90;
-                }
-            });
-        }
-        
-        // OTA Upload function
-        function uploadFirmware() {
-            const fileInput = document.getElementById('firmwareFile');
-            const uploadBtn = document.getElementById('uploadBtn');
-            const statusDiv = document.getElementById('otaStatus');
-            
-            if (!fileInput.files[0]) {
-                alert('Please select a firmware file first');
-                return;
-            }
-            
-            const file = fileInput.files[0];
-            if (!file.name.endsWith('.bin')) {
-                alert('Please select a valid .bin firmware file');
-                return;
-            }
-            
-            uploadBtn.disabled = true;
-            uploadBtn.textContent = 'Uploading...';
-            statusDiv.className = 'ota-status ota-progress';
-            statusDiv.textContent = 'Uploading firmware...';
-            
-            const formData = new FormData();
-            formData.append('firmware', file);
-            
-            fetch('/update', {
-                method: 'POST',
-                body: formData
-            })
-            .then(response => {
-                if (response.ok) {
-                    statusDiv.className = 'ota-status ota-success';
-                    statusDiv.textContent = 'Upload successful! Device is rebooting...';
-                    setTimeout(() => {
-                        location.reload();
-                    }, 5000);
-                } else {
-                    throw new Error('Upload failed');
-                }
-            })
-            .catch(error => {
-                console.error('Upload error:', error);
-                statusDiv.className = 'ota-status ota-error';
-                statusDiv.textContent = 'Upload failed. Please try again.';
-                uploadBtn.disabled = false;
-                uploadBtn.textContent = 'Upload Firmware';
-            });
-        }
-        
-        // Update individual servo
-        function updateServo(servoId, angle) {
-            document.getElementById(`value-${servoId}`).textContent = angle + '°';
-            servos[servoId] = parseInt(angle);
-            
-            fetch('/setServo', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify({ servo: servoId, angle: parseInt(angle) })
-            }).catch(err => {
-                console.error('Error setting servo:', err);
-                updateConnectionStatus(false);
-            });
-        }
-        
-        // Set all servos to same position
-        function setAllServos(angle) {
-            if (sweeping) return;
-            
-            for (let i = 0; i < 18; i++) {
-                document.getElementById(`servo-${i}`).value = angle;
-                document.getElementById(`value-${i}`).textContent = angle + '°';
-                servos[i] = angle;
-            }
-            
-            fetch('/setAll', {
-                method: 'POST',
-                headers: { 'Content-Type': 'application/json' },
-                body: JSON.stringify({ angle: angle })
-            }).catch(err => {
-                console.error('Error setting all servos:', err);
-                updateConnectionStatus(false);
-            });
-        }
-        
-        // Sweep test
-        async function sweepAll() {
-            if (sweeping) return;
-            sweeping = true;
-            
-            const btn = event.target;
-            btn.textContent = 'Sweeping...';
-            btn.disabled = true;
-            
-            try {
-                const response = await fetch('/sweep', { method: 'POST' });
-                if (response.ok) {
-                    // Update UI during sweep
-                    for (let angle = 0; angle <= 180; angle += 10) {
-                        await new Promise(resolve => setTimeout(resolve, 100));
-                        for (let i = 0; i < 18; i++) {
-                            document.getElementById(`servo-${i}`).value = angle;
-                            document.getElementById(`value-${i}`).textContent = angle + '°';
-                        }
-                    }
-                    for (let angle = 180; angle >= 0; angle -= 10) {
-                        await new Promise(resolve => setTimeout(resolve, 100));
-                        for (let i = 0; i < 18; i++) {
-                            document.getElementById(`servo-${i}`).value = angle;
-                            document.getElementById(`value-${i}`).textContent = angle + '°';
-                        }
-                    }
-                    // Return to center
-                    for (let i = 0; i < 18; i++) {
-                        document.getElementById(`servo-${i}`).value = 90;
-                        document.getElementById(`value-${i}`).textContent = '90°';
-                    }
-                }
-            } catch (err) {
-                console.error('Sweep error:', err);
-                updateConnectionStatus(false);
-            }
-            
-            btn.textContent = 'Sweep Test';
-            btn.disabled = false;
-            sweeping = false;
-        }
-        
-        // Get current positions
-        function getPositions() {
-            fetch('/getPositions')
-                .then(response => response.json())
-                .then(data => {
-                    for (let i = 0; i < 18; i++) {
-                        const angle = data.positions[i];
-                        document.getElementById(`servo-${i}`).value = angle;
-                        document.getElementById(`value-${i}`).textContent = angle + '°';
-                        servos[i] = angle;
-                    }
-                    updateConnectionStatus(true);
-                })
-                .catch(err => {
-                    console.error('Error getting positions:', err);
-                    updateConnectionStatus(false);
-                });
-        }
-        
-        // Update connection status
-        function updateConnectionStatus(connected) {
-            const status = document.getElementById('connectionStatus');
-            if (connected) {
-                status.textContent = 'Connected';
-                status.className = 'connection-status connected';
-            } else {
-                status.textContent = 'Disconnected';
-                status.className = 'connection-status disconnected';
-            }
-        }
+// Parse {"name":"..."} for the sequence endpoints; replies on failure
+bool parseSequenceName(AsyncWebServerRequest *request, ReqField &field) {
+  if (!parseBody(request, &field, 1, "Invalid name")) return false;
+  if (!validName(field.strVal)) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid name\"}");
+    return false;
+  }
+  return true;
+}
 
-        function standUp() {
-        fetch('/stand')  // GET request
-        .then(response => response.json())
-        .then(data => {
-            const positions = data.positions;
-            for (let i = 0; i < positions.length; i++) {
-                document.getElementById(`servo-${i}`).value = positions[i];
-                document.getElementById(`value-${i}`).textContent = positions[i] + '°';
-                servos[i] = positions[i];
-            }
-            updateConnectionStatus(true);
-        })
-        .catch(err => {
-            console.error('Stand error:', err);
-            updateConnectionStatus(false);
-        });
-        }
+// Handle sequence listing and status
+void handleSequenceList(AsyncWebServerRequest *request) {
+  sendSequenceStatus(request, true);
+}
 
-        function sitDown() {
-            fetch('/sit')  // GET request
-                .then(response => response.json())
-                .then(data => {
-                    const positions = data.positions;
-                    for (let i = 0; i < positions.length; i++) {
-                        document.getElementById(`servo-${i}`).value = positions[i];
-                        document.getElementById(`value-${i}`).textContent = positions[i] + '°';
-                        servos[i] = positions[i];
-                    }
-                    updateConnectionStatus(true);
-                })
-                .catch(err => {
-                    console.error('Sit Down error:', err);
-                    updateConnectionStatus(false);
-                });
-        }
+// Handle recording start: {"name":"demo"}
+void handleSequenceRecord(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
 
-        // Check connection periodically
-        setInterval(() => {
-            fetch('/ping')
-                .then(() => updateConnectionStatus(true))
-                .catch(() => updateConnectionStatus(false));
-        }, 5000);
-        
-        // Initialize on load
-        window.onload = function() {
-            initControls();
-            getPositions();
-        };
-    </script>
-</body>
-</html>
-)rawliteral";
+  ReqField field = { "name", FIELD_STR, true };
+  if (!parseSequenceName(request, field)) return;
+  if (seqState != SEQ_IDLE) {
+    request->send(409, "application/json", "{\"status\":\"error\",\"message\":\"Sequence busy\"}");
+    return;
+  }
+  seqStartRecording(field.strVal);
+  sendSequenceStatus(request, false);
+  Serial.printf("Recording sequence %s\n", seqName);
+}
 
+// Handle playback start: {"name":"demo"}
+void handleSequencePlay(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
+  }
 
+  ReqField field = { "name", FIELD_STR, true };
+  if (!parseSequenceName(request, field)) return;
+  if (seqState != SEQ_IDLE) {
+    request->send(409, "application/json", "{\"status\":\"error\",\"message\":\"Sequence busy\"}");
+    return;
+  }
+  if (!seqStartPlayback(field.strVal)) {
+    request->send(404, "application/json", "{\"status\":\"error\",\"message\":\"No such sequence\"}");
+    return;
+  }
+  sendSequenceStatus(request, false);
+  Serial.printf("Playing sequence %s as job %u\n", seqName, seqJob);
+}
 
+// Handle stop: ends recording, or halts playback where the robot is
+void handleSequenceStop(AsyncWebServerRequest *request) {
+  if (seqState == SEQ_PLAYING) {
+    cmdSimple(CMD_HOLD);
+    seqStop("stopped");
+  } else if (seqState == SEQ_RECORDING) {
+    // No more captures; seqService() writes what is left and closes
+    recActive.store(false, std::memory_order_relaxed);
+    seqState = SEQ_STOPPING;
+  }
+  sendSequenceStatus(request, false);
+}
 
+// Handle sequence removal: {"name":"demo"}
+void handleSequenceDelete(AsyncWebServerRequest *request) {
+  ReqField field = { "name", FIELD_STR, true };
+  if (!parseSequenceName(request, field)) return;
+  if (seqState != SEQ_IDLE && strcmp(seqName, field.strVal) == 0) {
+    request->send(409, "application/json", "{\"status\":\"error\",\"message\":\"Sequence busy\"}");
+    return;
+  }
 
-// Handle root request
-void handleRoot() {
-  server.send(200, "text/html", dashboard_html);
+  // Judged from the last directory scan; seqService() removes the file
+  bool listed = false;
+  for (int i = 0; i < seqListCount && !listed; i++) listed = strcmp(seqList[i].name, field.strVal) == 0;
+  if (seqRemovePending(field.strVal) || (!listed && !seqListFull)) {
+    request->send(404, "application/json", "{\"status\":\"error\",\"message\":\"No such sequence\"}");
+    return;
+  }
+  if (seqRemoveCount == SEQ_LIST_MAX) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Busy\"}");
+    return;
+  }
+  strlcpy(seqRemoving[seqRemoveCount++].name, field.strVal, REQ_STR_LEN);
+  request->send(200, "application/json", "{\"status\":\"success\"}");
 }
 
-void standUp() 
-{
-  // Assuming servo indexing:
-  // Coxa servos = 0,3,6,9,12,15
-  // Femur servos = 1,4,7,10,13,16
-  // Tibia servos = 2,5,8,11,14,17
+// Telemetry push. Every telemetryIntervalMs the robot state is serialised
+// once into the response buffer and broadcast as a text frame to every
+// WebSocket client, so the work does not grow with the number of viewers.
+#define TELEMETRY_DEFAULT_MS 100
+#define TELEMETRY_MIN_MS 20
 
-  int coxaIDs[] = {0,3,6,9,12,15};
-  int femurIDs[] = {1,4,7,10,13,16};
-  int tibiaIDs[] = {2,5,8,11,14,17};
+uint16_t telemetryIntervalMs = TELEMETRY_DEFAULT_MS;  // 0 = off
+uint32_t telemetryLastMs = 0;
+uint32_t telemetrySent = 0;
+uint32_t loopLastUs = 0;
+uint32_t loopMaxUs = 0;      // worst loop() period since the last broadcast
 
-  for (int i : coxaIDs) {
-    servoPositions[i] = 90;  
-    pwm.setPWM(i, 0, angleToPWM(90));
-  }
-  for (int i : femurIDs) {
-    servoPositions[i] = 32;  
-    pwm.setPWM(i, 0, angleToPWM(32));
+void telemetryService() {
+  uint32_t nowUs = micros();
+  if (loopLastUs && nowUs - loopLastUs > loopMaxUs) loopMaxUs = nowUs - loopLastUs;
+  loopLastUs = nowUs;
+
+  uint32_t nowMs = millis();
+  if (telemetryIntervalMs == 0 || nowMs - telemetryLastMs < telemetryIntervalMs) return;
+  telemetryLastMs = nowMs;
+  if (webSocket.connectedClients() == 0) {
+    loopMaxUs = 0;
+    return;
   }
-  for (int i : tibiaIDs) {
-    servoPositions[i] = 50;  
-    pwm.setPWM(i, 0, angleToPWM(50));
+
+  uint16_t pose[NUM_SERVOS];
+  poseSnapshot(pose);
+  MotionStatus st;
+  statusSnapshot(st);
+
+  respBegin();
+  respRaw("{\"type\":\"telemetry\",\"seq\":");
+  respUInt(telemetrySent);
+  respRaw(",");
+  respPositions(pose);
+  respRaw(",\"job\":");
+  respUInt(st.activeJob);
+  respRaw(",\"lastDoneJob\":");
+  respUInt(st.lastDoneJob);
+  respRaw(",\"queued\":");
+  respUInt(st.queued);
+  respRaw(",\"gait\":\"");
+  respRaw(st.gait != 0xFF ? gaitPatterns[st.gait].name : "idle");
+  respRaw("\",\"sequence\":\"");
+  respRaw(seqStateNames[seqState]);
+  respRaw("\",\"loopMaxUs\":");
+  respUInt(loopMaxUs);
+  respRaw(",\"tickOverruns\":");
+  respUInt(st.overruns);
+  respRaw(",\"ota\":\"");
+  respRaw(otaStatus.c_str());
+  respRaw("\"}");
+
+  webSocket.broadcastTXT(responseBuf, responseLen);
+  telemetrySent++;
+  loopMaxUs = 0;
+}
+
+// Handle telemetry rate change: {"intervalMs":n}, 0 turns the push off
+void handleTelemetry(AsyncWebServerRequest *request) {
+  ReqField fields[] = {
+    { "intervalMs", FIELD_INT, true, 0, 5000 },
+  };
+  if (!parseBody(request, fields, 1, "Invalid interval")) return;
+  if (fields[0].intVal != 0 && fields[0].intVal < TELEMETRY_MIN_MS) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid interval\"}");
+    return;
   }
 
-  Serial.println("Robot moved to Stand Up position");
+  telemetryIntervalMs = fields[0].intVal;
+  respBegin();
+  respRaw("{\"status\":\"success\",\"intervalMs\":");
+  respUInt(telemetryIntervalMs);
+  respRaw("}");
+  respSend(request, 200);
 }
 
-void sitDown() 
-{
-  // Assuming servo indexing:
-  // Coxa servos = 0,3,6,9,12,15
-  // Femur servos = 1,4,7,10,13,16
-  // Tibia servos = 2,5,8,11,14,17
+#if ENABLE_METRICS
+// Handle metrics scrape in Prometheus text format, written line by line
+// into a response stream
+void handleMetrics(AsyncWebServerRequest *request) {
+  AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
 
-  int coxaIDs[] = {0,3,6,9,12,15};
-  int femurIDs[] = {1,4,7,10,13,16};
-  int tibiaIDs[] = {2,5,8,11,14,17};
+  const char *header =
+    "# TYPE hexapod_latency_us summary\n"
+    "# TYPE hexapod_latency_min_us gauge\n"
+    "# TYPE hexapod_latency_max_us gauge\n"
+    "# TYPE hexapod_latency_avg_us gauge\n";
+  response->print(header);
 
-  for (int i : coxaIDs) {
-    servoPositions[i] = 90;  
-    pwm.setPWM(i, 0, angleToPWM(90));
-  }
-  for (int i : femurIDs) {
-    servoPositions[i] = 100;  
-    pwm.setPWM(i, 0, angleToPWM(100));
-  }
-  for (int i : tibiaIDs) {
-    servoPositions[i] = 20;  
-    pwm.setPWM(i, 0, angleToPWM(20));
+  for (int i = 0; i < METRIC_COUNT; i++) {
+    const LatencyHist &h = metrics[i];
+    uint32_t avg = h.count ? h.sumUs / h.count : 0;
+    response->printf("hexapod_latency_us{path=\"%s\",quantile=\"0.99\"} %u\n"
+                     "hexapod_latency_us_sum{path=\"%s\"} %llu\n"
+                     "hexapod_latency_us_count{path=\"%s\"} %u\n",
+                     metricNames[i], (unsigned)histQuantile(h, 990),
+                     metricNames[i], (unsigned long long)h.sumUs,
+                     metricNames[i], (unsigned)h.count);
+    response->printf("hexapod_latency_min_us{path=\"%s\"} %u\n"
+                     "hexapod_latency_max_us{path=\"%s\"} %u\n"
+                     "hexapod_latency_avg_us{path=\"%s\"} %u\n",
+                     metricNames[i], (unsigned)h.minUs,
+                     metricNames[i], (unsigned)h.maxUs,
+                     metricNames[i], (unsigned)avg);
   }
 
-  Serial.println("Robot moved to sit Down position");
+  response->printf("# TYPE hexapod_i2c_transactions_total counter\n"
+                   "hexapod_i2c_transactions_total %u\n"
+                   "# TYPE hexapod_i2c_bytes_total counter\n"
+                   "hexapod_i2c_bytes_total %u\n",
+                   (unsigned)i2cTransactions, (unsigned)i2cBytes);
+  response->print("# TYPE hexapod_i2c_board_transactions_total counter\n"
+                  "# TYPE hexapod_i2c_board_bytes_total counter\n"
+                  "# TYPE hexapod_i2c_board_errors_total counter\n");
+  for (int b = 0; b <= PCA9685_BOARDS; b++) {
+    const BusStats &bus = b < PCA9685_BOARDS ? boardStats[b] : allCallStats;
+    uint8_t address = b < PCA9685_BOARDS ? boardAddress[b] : PCA9685_ALLCALL_ADDRESS;
+    response->printf("hexapod_i2c_board_transactions_total{board=\"0x%02x\"} %u\n"
+                     "hexapod_i2c_board_bytes_total{board=\"0x%02x\"} %u\n"
+                     "hexapod_i2c_board_errors_total{board=\"0x%02x\"} %u\n",
+                     address, (unsigned)bus.transactions,
+                     address, (unsigned)bus.bytes,
+                     address, (unsigned)bus.errors);
+  }
+  response->printf("# TYPE hexapod_free_heap_bytes gauge\n"
+                   "hexapod_free_heap_bytes %u\n",
+                   (unsigned)ESP.getFreeHeap());
+  request->send(response);
 }
+#endif
 
+// Output limits as last configured, kept on the handler side for reporting
+uint16_t limitMaxVel[NUM_SERVOS];
+uint16_t limitMaxAccel[NUM_SERVOS];
+LimitSetting limitCurrent;
 
-void handleStand() {
-  standUp();  
-  // return JSON with updated positions so UI can sync
-  String json = "{\"status\":\"success\",\"action\":\"stand\",\"positions\":[";
+#define LIMIT_DEFAULT_VEL 400      // deg/s
+#define LIMIT_DEFAULT_ACCEL 4000   // deg/s^2
+#define LIMIT_DEFAULT_JOINT_MA 700
+#define LIMIT_DEFAULT_BUDGET_MA 5000
+
+void limitDefaults() {
+  LimitSetting set = { LIMIT_DEFAULT_VEL, LIMIT_DEFAULT_ACCEL, LIMIT_DEFAULT_JOINT_MA, LIMIT_DEFAULT_BUDGET_MA };
   for (int i = 0; i < NUM_SERVOS; i++) {
-    json += String(servoPositions[i]);
-    if (i < NUM_SERVOS - 1) json += ",";
+    limitMaxVel[i] = set.maxVel;
+    limitMaxAccel[i] = set.maxAccel;
   }
-  json += "]}";
-  server.send(200, "application/json", json);
+  limitCurrent = set;
+  limitApply((1UL << NUM_SERVOS) - 1, set);
 }
 
-void handleSit() {
-  sitDown();
-  // return JSON with updated positions so UI can sync
-  String json = "{\"status\":\"success\",\"action\":\"sit\",\"positions\":[";
+// Handle output limit read
+void handleGetLimits(AsyncWebServerRequest *request) {
+  respBegin();
+  respRaw("{\"jointMa\":");
+  respUInt(limitCurrent.jointMa);
+  respRaw(",\"budgetMa\":");
+  respUInt(limitCurrent.budgetMa);
+  respRaw(",\"servos\":[");
   for (int i = 0; i < NUM_SERVOS; i++) {
-    json += String(servoPositions[i]);
-    if (i < NUM_SERVOS - 1) json += ",";
+    respRaw(i ? ",{\"maxVel\":" : "{\"maxVel\":");
+    respUInt(limitMaxVel[i]);
+    respRaw(",\"maxAccel\":");
+    respUInt(limitMaxAccel[i]);
+    respRaw("}");
   }
-  json += "]}";
-  server.send(200, "application/json", json);
+  respRaw("]}");
+  respSend(request, 200);
 }
 
-// Handle OTA update upload
-void handleUpdate() {
-  HTTPUpload& upload = server.upload();
-  
-  if (upload.status == UPLOAD_FILE_START) {
-    Serial.printf("Update: %s\n", upload.filename.c_str());
-    otaInProgress = true;
-    otaStatus = "Starting update...";
-    
-    // Stop all servo operations
-    for (int i = 0; i < NUM_SERVOS; i++) {
-      pwm.setPWM(i, 0, 0);
-    }
-    
-    if (!Update.begin(UPDATE_SIZE_UNKNOWN)) {
-      Update.printError(Serial);
-      otaStatus = "Update begin failed";
-      otaInProgress = false;
-    }
-  } else if (upload.status == UPLOAD_FILE_WRITE) {
-    if (Update.write(upload.buf, upload.currentSize) != upload.currentSize) {
-      Update.printError(Serial);
-      otaStatus = "Update write failed";
-      otaInProgress = false;
-    } else {
-      otaStatus = "Uploading: " + String((Update.progress() * 100) / Update.size()) + "%";
-    }
-  } else if (upload.status == UPLOAD_FILE_END) {
-    if (Update.end(true)) {
-      Serial.printf("Update Success: %uB\n", upload.totalSize);
-      otaStatus = "Update complete - Rebooting...";
-      server.send(200, "text/plain", "OK");
-      delay(1000);
-      ESP.restart();
-    } else {
-      Update.printError(Serial);
-      otaStatus = "Update end failed";
-      otaInProgress = false;
-      // Reinitialize servos after failed update
-      initServos();
-    }
+// Handle output limit update; omitted fields keep their value. Without
+// "servo" the joint limits apply to every servo.
+// {"servo":n,"maxVel":deg/s,"maxAccel":deg/s^2,"jointMa":mA,"budgetMa":mA}
+void handleSetLimits(AsyncWebServerRequest *request) {
+  ReqField fields[] = {
+    { "servo", FIELD_INT, false, 0, NUM_SERVOS - 1 },
+    { "maxVel", FIELD_INT, false, 0, 2000 },
+    { "maxAccel", FIELD_INT, false, 0, 40000 },
+    { "jointMa", FIELD_INT, false, 0, 5000 },
+    { "budgetMa", FIELD_INT, false, 0, 60000 },
+  };
+  if (!parseBody(request, fields, 5, "Invalid parameters")) return;
+
+  uint32_t mask = fields[0].seen ? 1UL << fields[0].intVal : (1UL << NUM_SERVOS) - 1;
+  if (cmdFree() < (uint32_t)__builtin_popcount(mask)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
   }
-}
 
-// Handle individual servo control
-void handleSetServo() {
-  if (otaInProgress) {
-    server.send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+  LimitSetting set = limitCurrent;
+  if (fields[1].seen) set.maxVel = fields[1].intVal;
+  if (fields[2].seen) set.maxAccel = fields[2].intVal;
+  if (fields[3].seen) set.jointMa = fields[3].intVal;
+  if (fields[4].seen) set.budgetMa = fields[4].intVal;
+  // A budget below one joint's start surge would hold every joint at rest
+  if (set.budgetMa && set.budgetMa < set.jointMa) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"budgetMa below jointMa\"}");
     return;
   }
-  
-  if (server.hasArg("plain")) {
-    DynamicJsonDocument doc(1024);
-    deserializeJson(doc, server.arg("plain"));
-    
-    int servoId = doc["servo"];
-    int angle = doc["angle"];
-    
-    if (servoId >= 0 && servoId < NUM_SERVOS && angle >= 0 && angle <= 180) {
-      servoPositions[servoId] = angle;
-      pwm.setPWM(servoId, 0, angleToPWM(angle));
-      
-      server.send(200, "application/json", "{\"status\":\"success\"}");
-      Serial.printf("Servo %d set to %d degrees\n", servoId + 1, angle);
-    } else {
-      server.send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid parameters\"}");
+
+  // Joints keep their own limits unless a value was given for them
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (!(mask & (1UL << i))) continue;
+    LimitSetting joint = set;
+    if (!fields[1].seen) joint.maxVel = limitMaxVel[i];
+    if (!fields[2].seen) joint.maxAccel = limitMaxAccel[i];
+    if (!cmdLimits(1UL << i, joint)) {
+      request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+      return;
     }
-  } else {
-    server.send(400, "application/json", "{\"status\":\"error\",\"message\":\"No data received\"}");
+    limitMaxVel[i] = joint.maxVel;
+    limitMaxAccel[i] = joint.maxAccel;
   }
+  limitCurrent.jointMa = set.jointMa;
+  limitCurrent.budgetMa = set.budgetMa;
+  request->send(200, "application/json", "{\"status\":\"success\"}");
 }
 
-// Handle set all servos
-void handleSetAll() {
-  if (otaInProgress) {
-    server.send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
-    return;
+// Pulse phase setting, kept in NVS
+uint16_t phaseStep = PHASE_DEFAULT_STEP;
+
+void phaseLoad() {
+  phaseStep = prefs.getUShort("phaseStep", PHASE_DEFAULT_STEP) % PCA9685_PERIOD;
+  phaseApply(phaseStep);
+}
+
+// Most pulses high at once for the live pulse widths, with ON counts
+// step apart
+int phasePeakPulses(uint16_t step) {
+  MotionStatus st;
+  statusSnapshot(st);
+  uint16_t on[NUM_SERVOS], width[NUM_SERVOS];
+  for (int ch = 0; ch < NUM_SERVOS; ch++) {
+    on[ch] = (uint32_t)ch * step % PCA9685_PERIOD;
+    width[ch] = st.frameTicks[ch];
   }
-  
-  if (server.hasArg("plain")) {
-    DynamicJsonDocument doc(1024);
-    deserializeJson(doc, server.arg("plain"));
-    
-    int angle = doc["angle"];
-    
-    if (angle >= 0 && angle <= 180) {
-      for (int i = 0; i < NUM_SERVOS; i++) {
-        servoPositions[i] = angle;
-        pwm.setPWM(i, 0, angleToPWM(angle));
-      }
-      
-      server.send(200, "application/json", "{\"status\":\"success\"}");
-      Serial.printf("All servos set to %d degrees\n", angle);
-    } else {
-      server.send(400, "application/json", "{\"status\":\"error\",\"message\":\"Invalid angle\"}");
+  // The count peaks at some pulse's rising edge
+  int peak = 0;
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    if (!width[i]) continue;
+    int high = 0;
+    for (int j = 0; j < NUM_SERVOS; j++) {
+      if ((uint16_t)(on[i] - on[j]) % PCA9685_PERIOD < width[j]) high++;
     }
-  } else {
-    server.send(400, "application/json", "{\"status\":\"error\",\"message\":\"No data received\"}");
+    if (high > peak) peak = high;
   }
+  return peak;
 }
 
-// Handle sweep test
-void handleSweep() {
-  if (otaInProgress) {
-    server.send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+// Handle pulse phase query, with the overlap it gives for the live pose
+void handleGetPhase(AsyncWebServerRequest *request) {
+  char json[96];
+  snprintf(json, sizeof(json), "{\"phaseStep\":%u,\"peakPulses\":%d,\"peakPulsesAligned\":%d}",
+           phaseStep, phasePeakPulses(phaseStep), phasePeakPulses(0));
+  request->send(200, "application/json", json);
+}
+
+// Handle pulse phase update: {"phaseStep":counts}, 0 starts every pulse
+// together
+void handleSetPhase(AsyncWebServerRequest *request) {
+  ReqField field = { "phaseStep", FIELD_INT, true, 0, PCA9685_PERIOD - 1 };
+  if (!parseBody(request, &field, 1, "Invalid phaseStep")) return;
+
+  MotionCmd cmd = {};
+  cmd.type = CMD_PHASE;
+  cmd.phaseStep = field.intVal;
+  if (!cmdPush(cmd)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
     return;
   }
-  
-  Serial.println("Starting sweep test...");
-  
-  // Sweep from 0 to 180
-  for (int angle = 0; angle <= 180; angle += 10) {
-    for (int i = 0; i < NUM_SERVOS; i++) {
-      servoPositions[i] = angle;
-      pwm.setPWM(i, 0, angleToPWM(angle));
-    }
-    delay(100);
-  }
-  
-  // Sweep back from 180 to 0
-  for (int angle = 180; angle >= 0; angle -= 10) {
-    for (int i = 0; i < NUM_SERVOS; i++) {
-      servoPositions[i] = angle;
-      pwm.setPWM(i, 0, angleToPWM(angle));
-    }
-    delay(100);
-  }
-  
-  // Return to center
+  phaseStep = field.intVal;
+  persistDirty |= PERSIST_PHASE;
+  handleGetPhase(request);
+}
+
+// Handle calibration table read
+void handleGetCalibration(AsyncWebServerRequest *request) {
+  respBegin();
+  respRaw("{\"servos\":[");
   for (int i = 0; i < NUM_SERVOS; i++) {
-    servoPositions[i] = 90;
-    pwm.setPWM(i, 0, angleToPWM(90));
+    const ServoCal &cal = calConfig[i];
+    respRaw(i ? ",{\"min\":" : "{\"min\":");
+    respUInt(cal.minTicks);
+    respRaw(",\"max\":");
+    respUInt(cal.maxTicks);
+    respRaw(",\"trim\":");
+    if (cal.trim < 0) respRaw("-");
+    respUInt(abs(cal.trim));
+    respRaw(",\"invert\":");
+    respUInt(cal.invert);
+    respRaw("}");
   }
-  
-  server.send(200, "application/json", "{\"status\":\"success\"}");
-  Serial.println("Sweep test completed");
+  respRaw("]}");
+  respSend(request, 200);
 }
 
-// Handle get positions
-void handleGetPositions() {
-  String json = "{\"positions\":[";
-  for (int i = 0; i < NUM_SERVOS; i++) {
-    json += String(servoPositions[i]);
-    if (i < NUM_SERVOS - 1) json += ",";
+// Handle calibration update for one servo; omitted fields keep their value
+// {"servo":n,"min":ticks,"max":ticks,"trim":cdeg,"invert":0|1}
+void handleSetCalibration(AsyncWebServerRequest *request) {
+  if (otaInProgress) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"OTA update in progress\"}");
+    return;
   }
-  json += "],\"otaStatus\":\"" + otaStatus + "\"}";
-  
-  server.send(200, "application/json", json);
+
+  ReqField fields[] = {
+    { "servo", FIELD_INT, true, 0, NUM_SERVOS - 1 },
+    { "min", FIELD_INT, false, 0, 4095 },
+    { "max", FIELD_INT, false, 0, 4095 },
+    { "trim", FIELD_INT, false, -1000, 1000 },
+    { "invert", FIELD_INT, false, 0, 1 },
+  };
+  if (!parseBody(request, fields, 5, "Invalid parameters")) return;
+
+  int servo = fields[0].intVal;
+  ServoCal cal = calConfig[servo];
+  if (fields[1].seen) cal.minTicks = fields[1].intVal;
+  if (fields[2].seen) cal.maxTicks = fields[2].intVal;
+  if (fields[3].seen) cal.trim = fields[3].intVal;
+  if (fields[4].seen) cal.invert = fields[4].intVal;
+
+  if (cal.minTicks >= cal.maxTicks) {
+    request->send(400, "application/json", "{\"status\":\"error\",\"message\":\"min must be below max\"}");
+    return;
+  }
+  if (!cmdCalibrate(servo, cal)) {
+    request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Command queue full\"}");
+    return;
+  }
+
+  calConfig[servo] = cal;
+  persistDirty |= PERSIST_CAL;
+  request->send(200, "application/json", "{\"status\":\"success\"}");
+  Serial.printf("Servo %d calibration: %u-%u ticks, trim %d, invert %u\n",
+                servo + 1, cal.minTicks, cal.maxTicks, cal.trim, cal.invert);
 }
 
 // Handle ping for connection check
-void handlePing() {
-  server.send(200, "application/json", "{\"status\":\"ok\",\"ota\":\"" + otaStatus + "\"}");
+void handlePing(AsyncWebServerRequest *request) {
+  respBegin();
+  respRaw("{\"status\":\"ok\",\"ota\":\"");
+  respRaw(otaStatus.c_str());
+  respRaw("\"}");
+  respSend(request, 200);
+}
+
+// Settings staged by persistTake() for persistWrite()
+struct PersistJob {
+  uint8_t dirty;
+  uint8_t poseSlots;
+  uint16_t phaseStep;
+  ServoCal cal[NUM_SERVOS];
+  NamedPose poses[POSE_USER_SLOTS];
+};
+
+PersistJob persistJob;
+
+// Under apiLock: copy out what the handlers changed
+bool persistTake() {
+  if (!persistDirty && !persistPoseSlots) return false;
+  persistJob.dirty = persistDirty;
+  persistJob.poseSlots = persistPoseSlots;
+  persistJob.phaseStep = phaseStep;
+  memcpy(persistJob.cal, calConfig, sizeof(persistJob.cal));
+  memcpy(persistJob.poses, userPoses, sizeof(persistJob.poses));
+  persistDirty = 0;
+  persistPoseSlots = 0;
+  return true;
+}
+
+// Without apiLock; after setup() only loop() touches prefs
+void persistWrite() {
+  if (persistJob.dirty & PERSIST_CAL) calSave(persistJob.cal);
+  if (persistJob.dirty & PERSIST_PHASE) prefs.putUShort("phaseStep", persistJob.phaseStep);
+  for (int i = 0; i < POSE_USER_SLOTS; i++) {
+    if (persistJob.poseSlots & (1 << i)) poseSaveSlot(i, persistJob.poses[i]);
+  }
 }
 
 void setup() {
@@ -936,15 +3726,31 @@ void setup() {
   // Initialize I2C communication
   Wire.begin(SDA_PIN, SCL_PIN);
   
-  // Initialize PCA9685
-  pwm.begin();
-  pwm.setOscillatorFrequency(27000000);
-  pwm.setPWMFreq(SERVO_FREQ);
+  // Initialize every PCA9685 on the servo bus
+  busInit();
   
   delay(100);
   
+  // Build kinematics and per-servo calibration lookup tables
+  ikInit();
+  bodyInit();
+  calLoad();
+  phaseLoad();
+  poseLoad();
+  limitDefaults();
+
+  // Sequence storage; formats the partition on first boot
+  if (LittleFS.begin(true)) {
+    LittleFS.mkdir("/seq");
+  } else {
+    Serial.println("LittleFS mount failed");
+  }
+
   // Initialize all servos to center position
   initServos();
+  posePublish();
+  statusPublish();
+  for (int i = 0; i < NUM_SERVOS; i++) motionTarget[i] = CDEG(90);
   Serial.println("Servos initialized to center position");
 
     // Static IP setup
@@ -976,33 +3782,113 @@ void setup() {
   setupOTA();
   
   // Setup web server routes
-  server.on("/", handleRoot);
-  server.on("/setServo", HTTP_POST, handleSetServo);
-  server.on("/setAll", HTTP_POST, handleSetAll);
-  server.on("/sweep", HTTP_POST, handleSweep);
-  server.on("/getPositions", HTTP_GET, handleGetPositions);
-  server.on("/ping", HTTP_GET, handlePing);
-  server.on("/update", HTTP_POST, []() {
-    server.send(200, "text/plain", (Update.hasError()) ? "FAIL" : "OK");
-  }, handleUpdate);
+  apiLock = xSemaphoreCreateMutex();
+  server.on("/", HTTP_GET, handleRoot);
+  apiOn("/setServo", HTTP_POST, handleSetServo);
+  apiOn("/setAll", HTTP_POST, handleSetAll);
+  apiOn("/sweep", HTTP_POST, handleSweep);
+  apiOn("/getPositions", HTTP_GET, handleGetPositions);
+  apiOn("/ping", HTTP_GET, handlePing);
+  apiOn("/motion", HTTP_GET, handleMotion);
+  apiOn("/gait", HTTP_POST, handleGait);
+  apiOn("/body", HTTP_GET, handleGetBody);
+  apiOn("/body", HTTP_POST, handleBody);
+  apiOn("/calibration", HTTP_GET, handleGetCalibration);
+  apiOn("/calibration", HTTP_POST, handleSetCalibration);
+  apiOn("/limits", HTTP_GET, handleGetLimits);
+  apiOn("/limits", HTTP_POST, handleSetLimits);
+  apiOn("/phase", HTTP_GET, handleGetPhase);
+  apiOn("/phase", HTTP_POST, handleSetPhase);
+  apiOn("/telemetry", HTTP_POST, handleTelemetry);
+  apiOn("/sequence", HTTP_GET, handleSequenceList);
+  apiOn("/sequence/record", HTTP_POST, handleSequenceRecord);
+  apiOn("/sequence/play", HTTP_POST, handleSequencePlay);
+  apiOn("/sequence/stop", HTTP_POST, handleSequenceStop);
+  apiOn("/sequence/delete", HTTP_POST, handleSequenceDelete);
+#if ENABLE_METRICS
+  apiOn("/metrics", HTTP_GET, handleMetrics);
+#endif
+  server.on("/update", HTTP_POST, [](AsyncWebServerRequest *request) {
+    if (otaRestartPending) {
+      request->send(200, "text/plain", "OK");
+    } else {
+      request->send(500, "text/plain", "FAIL");
+    }
+  }, [](AsyncWebServerRequest *request, const String &filename, size_t index,
+        uint8_t *data, size_t len, bool final) {
+    ApiGuard guard(portMAX_DELAY);
+    handleUpdate(request, filename, index, data, len, final);
+  });
   
-  server.on("/stand", HTTP_GET, handleStand);
-  server.on("/sit", HTTP_GET, handleSit);
+  apiOn("/stand", HTTP_GET, handleStand);
+  apiOn("/sit", HTTP_GET, handleSit);
+  apiOn("/release", HTTP_POST, handleRelease);
+  // Before /pose, which also matches every path below it
+  apiOn("/pose/save", HTTP_POST, handlePoseSave);
+  apiOn("/pose/delete", HTTP_POST, handlePoseDelete);
+  apiOn("/pose", HTTP_GET | HTTP_POST, handlePose);
 
   // Start server
   server.begin();
   Serial.println("Web server started!");
+
+  // Streaming control channel
+  webSocket.begin();
+  webSocket.onEvent(onWebSocketEvent);
+
+  // Teleoperation channel
+  udp.begin(UDP_PORT);
   Serial.println("Open your browser and go to: http://" + WiFi.localIP().toString());
   Serial.println("OTA Hostname: ESP32-ServoController");
   Serial.println("OTA Password: servo123");
+
+  // From here on only the motion tick touches the servos
+#if MOTION_TASK
+  xTaskCreatePinnedToCore(motionTask, "motion", 4096, nullptr, MOTION_PRIORITY,
+                          &motionTaskHandle, MOTION_CORE);
+#else
+  motionNextTickUs = micros();
+#endif
 }
 
 void loop() {
-  // Handle OTA updates
-  ArduinoOTA.handle();
-  
-  // Handle web server requests
-  server.handleClient();
+  bool persist;
+  {
+    METRIC_SCOPE(METRIC_LOOP);
+
+    // Handle OTA updates; its callbacks take apiLock themselves
+    ArduinoOTA.handle();
+    
+    // HTTP requests are served by the async server; everything below
+    // shares the command producer with its handlers
+    ApiGuard guard(portMAX_DELAY);
+    webSocket.loop();
+    udpService();
+
+    // Hand coalesced streamed joints to the motion tick
+    streamFlush();
+
+    // Record or play back a motion sequence
+    seqService();
+
+    // Push state to dashboard clients
+    telemetryService();
+
+#if !MOTION_TASK
+    // Advance queued motion at the fixed tick rate
+    motionService(micros());
+#endif
+
+    persist = persistTake();
+  }
+
+  // Settings changed by handlers go to flash outside the lock
+  if (persist) persistWrite();
+
+  // Reboot into the new image once the upload reply has gone out
+  if (otaRestartPending && (int32_t)(millis() - otaRestartAtMs) >= 0) {
+    ESP.restart();
+  }
   
   // Small delay to prevent watchdog issues
   delay(1);
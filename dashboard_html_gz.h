@@ -0,0 +1,289 @@
+// Generated by gzip_dashboard.py from dashboard.html; do not edit.
+#pragma once
+
+#define DASHBOARD_ETAG "\"80a7765c76aa9f38\""
+
+const size_t dashboard_html_gz_len = 4486;
+const uint8_t dashboard_html_gz[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xd5, 0x5c, 0x5b, 0x73, 0xdb, 0x46,
+  0x96, 0x7e, 0xf7, 0xaf, 0x68, 0xd3, 0x33, 0x43, 0x72, 0x23, 0x50, 0x04, 0x25, 0xea, 0x42, 0x89,
+  0xaa, 0xc9, 0xd8, 0xce, 0x8c, 0x53, 0x33, 0xb1, 0x2a, 0x92, 0x77, 0x6a, 0x2a, 0x95, 0x2a, 0x37,
+  0x89, 0x06, 0xd9, 0x31, 0x08, 0x70, 0x80, 0xa6, 0x68, 0xc5, 0xa3, 0xb7, 0x7d, 0xde, 0x7d, 0xd9,
+  0xb7, 0x7d, 0xd8, 0xbf, 0x30, 0x8f, 0xfb, 0x3c, 0x7f, 0x68, 0xf7, 0x27, 0xec, 0x39, 0xdd, 0xb8,
+  0x36, 0xba, 0x41, 0xd0, 0x52, 0xb2, 0x59, 0xb9, 0x22, 0x82, 0x00, 0xfa, 0xf4, 0xe9, 0x73, 0xf9,
+  0xce, 0xa5, 0x5b, 0xb9, 0x7c, 0xfe, 0xea, 0xed, 0xcb, 0xdb, 0xbf, 0x5c, 0xbf, 0x26, 0x4b, 0xb1,
+  0x0a, 0xae, 0x9e, 0x5d, 0xe2, 0x07, 0x09, 0x68, 0xb8, 0x98, 0x76, 0x58, 0xd8, 0xc1, 0x1b, 0x8c,
+  0x7a, 0x57, 0xcf, 0x08, 0xfc, 0x5c, 0xae, 0x98, 0xa0, 0x64, 0xbe, 0xa4, 0x71, 0xc2, 0xc4, 0xb4,
+  0xf3, 0xee, 0xf6, 0x2b, 0xe7, 0xac, 0x53, 0x7e, 0x14, 0xd2, 0x15, 0x9b, 0x76, 0xee, 0x38, 0xdb,
+  0xae, 0xa3, 0x58, 0x74, 0xc8, 0x3c, 0x0a, 0x05, 0x0b, 0xe1, 0xd5, 0x2d, 0xf7, 0xc4, 0x72, 0xea,
+  0xb1, 0x3b, 0x3e, 0x67, 0x8e, 0xfc, 0x72, 0x40, 0x78, 0xc8, 0x05, 0xa7, 0x81, 0x93, 0xcc, 0x69,
+  0xc0, 0xa6, 0xee, 0x60, 0x98, 0x91, 0x12, 0x5c, 0x04, 0xec, 0xea, 0xf5, 0xcd, 0xf5, 0xd1, 0x88,
+  0xdc, 0xb0, 0xf8, 0x2e, 0x22, 0x2f, 0x81, 0x4e, 0x1c, 0x05, 0x01, 0x8b, 0x2f, 0x0f, 0xd5, 0x53,
+  0xf5, 0x66, 0x22, 0xee, 0xb3, 0x6b, 0xfc, 0xf9, 0x27, 0xf2, 0x29, 0xbf, 0xc6, 0x9f, 0x15, 0x8d,
+  0x17, 0x3c, 0x9c, 0x90, 0xe1, 0x45, 0xe5, 0xf6, 0x9a, 0x7a, 0x1e, 0x0f, 0x17, 0xb5, 0xfb, 0xb3,
+  0xe8, 0xa3, 0x93, 0xf0, 0x1f, 0xe5, 0xa3, 0x59, 0x14, 0x7b, 0x2c, 0x76, 0xe0, 0x56, 0xf1, 0xce,
+  0x43, 0x7e, 0xf5, 0xac, 0x18, 0xe2, 0xdd, 0x6b, 0x93, 0xfa, 0xc0, 0xab, 0xe3, 0xd3, 0x15, 0x0f,
+  0xee, 0x27, 0xa4, 0x7b, 0xc3, 0x16, 0x11, 0x23, 0xef, 0xde, 0x74, 0x0f, 0xc8, 0x2d, 0x5d, 0x46,
+  0x2b, 0x7a, 0x40, 0x7e, 0xcf, 0x42, 0x76, 0x07, 0x9f, 0xff, 0xcc, 0x62, 0x8f, 0x86, 0x70, 0x91,
+  0xd0, 0x30, 0x71, 0x12, 0x16, 0x73, 0x5f, 0xe3, 0x87, 0xce, 0x3f, 0x2c, 0xe2, 0x68, 0x13, 0x7a,
+  0x13, 0x12, 0xf0, 0x90, 0xd1, 0xd8, 0x59, 0xc4, 0xd4, 0xe3, 0x20, 0xd1, 0x9e, 0x7b, 0x34, 0xf6,
+  0xd8, 0xe2, 0x80, 0xbc, 0x38, 0x39, 0x39, 0x65, 0x8c, 0x92, 0xe1, 0xaf, 0xe1, 0xfa, 0xf4, 0xe4,
+  0x78, 0x46, 0x47, 0xc4, 0x1d, 0x0e, 0x7f, 0xdd, 0xaf, 0x92, 0x5a, 0xf1, 0xd0, 0x59, 0x32, 0xbe,
+  0x58, 0x8a, 0x09, 0x3e, 0xbe, 0x5b, 0x5a, 0x24, 0x32, 0x1a, 0xae, 0x9b, 0x17, 0x3c, 0x40, 0x95,
+  0x52, 0x60, 0x26, 0xae, 0xc9, 0xfa, 0xa3, 0x52, 0x2c, 0x4c, 0x30, 0x1a, 0x56, 0xc8, 0x54, 0x54,
+  0x41, 0xe8, 0x46, 0x44, 0xf6, 0x75, 0xc6, 0x8b, 0x19, 0xed, 0x8d, 0xc6, 0xe3, 0x03, 0x52, 0xfc,
+  0x1a, 0x0e, 0xce, 0xc7, 0x7d, 0x5d, 0x55, 0x52, 0x3d, 0x28, 0x8d, 0x4d, 0x02, 0x33, 0x8e, 0xf5,
+  0xf9, 0xa4, 0x2e, 0x97, 0xd4, 0x8b, 0xb6, 0x38, 0x27, 0x2e, 0x8b, 0x1c, 0xe3, 0x2f, 0x49, 0x7f,
+  0x78, 0x20, 0xff, 0x0d, 0x5c, 0x8d, 0x6a, 0x74, 0xc7, 0x62, 0x3f, 0xc0, 0x21, 0x4b, 0xee, 0x79,
+  0x2c, 0x6c, 0x96, 0x04, 0xfa, 0x45, 0x4d, 0x0c, 0x4d, 0x3a, 0x3b, 0xae, 0xa8, 0x2c, 0xd7, 0x97,
+  0xc6, 0xc4, 0x3c, 0x0a, 0xa2, 0x78, 0x42, 0xb6, 0x4b, 0x2e, 0x98, 0x45, 0x4b, 0x47, 0x35, 0xf1,
+  0x0a, 0xf6, 0x51, 0x38, 0x34, 0xe0, 0x0b, 0x10, 0xf1, 0x1c, 0xe6, 0x62, 0x71, 0x2b, 0xde, 0x97,
+  0xae, 0xc9, 0x78, 0xc1, 0x07, 0x18, 0x98, 0xc2, 0x60, 0xcc, 0x56, 0x26, 0x25, 0x82, 0x53, 0x08,
+  0x11, 0xad, 0xd0, 0x90, 0x76, 0x19, 0x4b, 0x22, 0xa8, 0xd8, 0x24, 0xda, 0x1c, 0x1e, 0x4f, 0xd6,
+  0x01, 0x05, 0xe7, 0xe0, 0x21, 0x4a, 0xc8, 0x99, 0x05, 0xd1, 0xfc, 0x43, 0x0b, 0x8b, 0xc8, 0xfe,
+  0x1b, 0x0e, 0x74, 0x91, 0xe5, 0x82, 0x01, 0x33, 0x30, 0xda, 0x42, 0xc5, 0x58, 0x46, 0x35, 0xe9,
+  0x95, 0x56, 0x0d, 0xb6, 0x56, 0x5e, 0xb5, 0xcd, 0x03, 0x00, 0x8c, 0xf4, 0x65, 0x59, 0xb4, 0x63,
+  0xa2, 0x10, 0x09, 0x0a, 0xfe, 0x3e, 0x17, 0x3c, 0x0a, 0x1b, 0xcc, 0xe7, 0x85, 0x7f, 0xe6, 0x9f,
+  0xfb, 0xb4, 0xd9, 0xf0, 0x6b, 0x6b, 0xb1, 0xb8, 0xb2, 0x41, 0x7d, 0x75, 0x2b, 0x52, 0xc4, 0x61,
+  0x28, 0x88, 0x31, 0x89, 0x02, 0xee, 0x91, 0x17, 0xec, 0x9c, 0xcd, 0x99, 0xdf, 0x7e, 0x39, 0xcb,
+  0x23, 0x6d, 0x45, 0xa9, 0x39, 0xa7, 0x46, 0xdf, 0x6c, 0x4f, 0xe3, 0x36, 0x82, 0xdb, 0xac, 0x83,
+  0x88, 0x7a, 0x36, 0x9b, 0xf2, 0x03, 0xa6, 0x2d, 0x6a, 0x41, 0xd7, 0x26, 0x39, 0x49, 0x67, 0x71,
+  0xc0, 0xc7, 0x56, 0x49, 0xdd, 0x65, 0xa4, 0x51, 0x00, 0x25, 0x67, 0x1b, 0xe3, 0x68, 0xfc, 0xdd,
+  0xcc, 0x98, 0xcf, 0x03, 0xe6, 0xf0, 0x70, 0xbd, 0x11, 0xba, 0x43, 0x01, 0x15, 0x98, 0xbe, 0x8e,
+  0xc6, 0x29, 0x56, 0x1a, 0xa0, 0x32, 0xd7, 0xa0, 0xdb, 0x46, 0x41, 0x9e, 0xe7, 0x35, 0x5a, 0xc8,
+  0xb8, 0xc1, 0xd8, 0xdd, 0xe3, 0x56, 0x96, 0x6a, 0x72, 0xe2, 0x9d, 0x4c, 0xda, 0x19, 0x48, 0xb5,
+  0x2e, 0x22, 0xa3, 0x5e, 0x24, 0x7b, 0xdb, 0x34, 0x54, 0xcd, 0xa2, 0xc0, 0x7b, 0x1c, 0xd0, 0xe1,
+  0x02, 0x62, 0x00, 0x3b, 0x88, 0xd2, 0x55, 0xe7, 0xf2, 0x8e, 0x99, 0xe7, 0xd1, 0x8b, 0xdc, 0x3e,
+  0xdd, 0xf1, 0xf8, 0x74, 0x74, 0x7c, 0x51, 0x22, 0x22, 0xc7, 0xae, 0xe3, 0x68, 0x11, 0xb3, 0x24,
+  0xa9, 0x0d, 0x77, 0xd9, 0xdc, 0x77, 0x8b, 0xe1, 0xc3, 0xf9, 0xf8, 0xf8, 0x64, 0x58, 0x1b, 0xce,
+  0xe2, 0x38, 0x8a, 0xf5, 0xb1, 0xfe, 0x99, 0x77, 0x5a, 0x9e, 0xfa, 0x74, 0xe4, 0xce, 0x0d, 0x53,
+  0x27, 0x9b, 0xf9, 0xdc, 0x34, 0xf3, 0x4e, 0xc6, 0x6b, 0x50, 0xe5, 0xac, 0x69, 0xc8, 0x02, 0x9b,
+  0xcb, 0x2c, 0x62, 0xae, 0x09, 0x19, 0xef, 0x38, 0xe0, 0x19, 0xf0, 0x5c, 0x30, 0x07, 0x26, 0xda,
+  0xac, 0x42, 0xd0, 0x64, 0xcc, 0xd6, 0x8c, 0x8a, 0x1e, 0x06, 0x70, 0xc7, 0xe7, 0xe2, 0x00, 0xed,
+  0x18, 0xc2, 0x7e, 0xef, 0x68, 0x0c, 0x5a, 0x3c, 0x20, 0xae, 0x1f, 0xf7, 0xfb, 0x06, 0xdf, 0xdb,
+  0x13, 0x88, 0x8c, 0x71, 0x04, 0xb3, 0x40, 0x07, 0x45, 0xb0, 0xfe, 0x39, 0x01, 0xb3, 0x05, 0x1e,
+  0x4a, 0x9b, 0x8c, 0x21, 0x81, 0xe3, 0x08, 0x7f, 0x13, 0x75, 0xed, 0x47, 0xf1, 0x0a, 0x22, 0xc9,
+  0x28, 0x21, 0x8c, 0x26, 0xac, 0xf5, 0xd2, 0x26, 0x4b, 0x4c, 0x40, 0xb4, 0x05, 0xe6, 0x04, 0x53,
+  0xda, 0xa8, 0x92, 0xbf, 0xf4, 0x1c, 0x60, 0xa9, 0xdf, 0x94, 0xf1, 0x64, 0x91, 0xd0, 0x9e, 0xf0,
+  0xd8, 0x99, 0x49, 0xad, 0xc6, 0x98, 0x4c, 0xef, 0x01, 0xd6, 0x8a, 0x58, 0x40, 0x67, 0x76, 0xd3,
+  0xab, 0xa3, 0xf5, 0x0f, 0x9b, 0x44, 0x70, 0xff, 0xde, 0x49, 0x2b, 0x87, 0x09, 0x49, 0xd6, 0x14,
+  0x4a, 0x86, 0x19, 0x13, 0x5b, 0x56, 0x4e, 0xc8, 0x5a, 0x41, 0xb8, 0xc6, 0xf2, 0x59, 0x23, 0xd6,
+  0x9c, 0x0c, 0x87, 0xc6, 0x44, 0xec, 0xc5, 0xf1, 0xf9, 0x78, 0x38, 0x3e, 0x6d, 0xb3, 0xd6, 0x3b,
+  0x1a, 0x6c, 0x58, 0x93, 0x81, 0x9a, 0x82, 0x60, 0x8b, 0x7c, 0x0f, 0xed, 0xef, 0x6c, 0x07, 0xcc,
+  0xba, 0xa3, 0xc6, 0xac, 0xe6, 0xac, 0x9e, 0xcc, 0x15, 0x41, 0xe8, 0xf8, 0xd1, 0xf9, 0xa4, 0x5a,
+  0x7f, 0x02, 0x2e, 0x52, 0x33, 0xe0, 0xac, 0x28, 0x80, 0xa2, 0xa4, 0x3a, 0x47, 0x56, 0x8f, 0x9c,
+  0xec, 0x58, 0xd9, 0x51, 0xed, 0x79, 0x05, 0x0e, 0xf5, 0xf8, 0x17, 0x6d, 0x04, 0xa6, 0x95, 0x13,
+  0x12, 0x46, 0xa1, 0x26, 0x50, 0xd0, 0xf5, 0xec, 0x03, 0x87, 0x85, 0xad, 0x01, 0xc8, 0xc0, 0x99,
+  0xe6, 0xc6, 0xb7, 0xe6, 0x9b, 0x38, 0x41, 0x8d, 0xac, 0x23, 0x5e, 0x37, 0xa9, 0xb2, 0xaf, 0x17,
+  0x7c, 0x80, 0x80, 0x8f, 0xda, 0x3b, 0xbb, 0x12, 0xd3, 0x64, 0x92, 0xb1, 0xa3, 0xbe, 0x3b, 0x62,
+  0xb9, 0x59, 0xcd, 0x34, 0xe1, 0xb5, 0xe3, 0xb8, 0xf9, 0x69, 0x9e, 0x69, 0xe8, 0x72, 0xcc, 0x14,
+  0x30, 0xda, 0x19, 0xc2, 0x75, 0xd5, 0xed, 0x36, 0xea, 0x26, 0x19, 0x6a, 0xb5, 0x19, 0x96, 0x66,
+  0x3a, 0x50, 0xe9, 0x19, 0x7e, 0x59, 0xec, 0x34, 0x08, 0xf6, 0x03, 0xd7, 0x26, 0x79, 0x1b, 0x31,
+  0xb7, 0xb2, 0xbc, 0x31, 0x3d, 0xf1, 0xbd, 0xb3, 0x0b, 0x1b, 0x28, 0xcb, 0xee, 0x45, 0xcf, 0x6d,
+  0x09, 0xad, 0x39, 0x2b, 0xab, 0xe8, 0x47, 0x10, 0x6f, 0xb8, 0x60, 0x46, 0xb5, 0xff, 0x02, 0x55,
+  0xa6, 0x22, 0x61, 0xdd, 0xba, 0xf6, 0x54, 0xa6, 0x49, 0x34, 0x7f, 0xdd, 0xf0, 0xf9, 0x07, 0x87,
+  0xca, 0x02, 0x22, 0x79, 0x74, 0x62, 0x6f, 0xcd, 0xdb, 0x8d, 0xe1, 0xa5, 0x21, 0x6c, 0xc8, 0x04,
+  0x75, 0x64, 0xcb, 0x17, 0x6c, 0x8f, 0x53, 0x3d, 0xa8, 0xa7, 0xfb, 0xd5, 0x51, 0x33, 0x11, 0x5a,
+  0xb3, 0x6c, 0x24, 0x35, 0x3a, 0xb6, 0x25, 0x28, 0x26, 0xb5, 0x54, 0x6b, 0xde, 0xc6, 0x32, 0xe0,
+  0x64, 0xcf, 0xc0, 0xd8, 0x16, 0x20, 0x95, 0xa7, 0xd6, 0x90, 0xb1, 0x6e, 0x36, 0xc7, 0x9f, 0x95,
+  0xad, 0x80, 0xbc, 0x20, 0x3f, 0xe7, 0xa0, 0xae, 0xfb, 0x9f, 0xa9, 0x0b, 0x63, 0xe3, 0x02, 0xaa,
+  0xdf, 0x28, 0xf4, 0x9a, 0xf9, 0x78, 0x71, 0x32, 0x3f, 0x1d, 0x9f, 0x7a, 0x8f, 0x9a, 0x26, 0xab,
+  0x08, 0xec, 0x93, 0x8c, 0xce, 0xe8, 0xe9, 0xf1, 0xf8, 0x31, 0x93, 0x6c, 0x69, 0x1c, 0x82, 0xcd,
+  0x35, 0xe6, 0xd9, 0xfe, 0xdc, 0x1d, 0x9e, 0x9a, 0xb3, 0xa5, 0x91, 0x3b, 0x1a, 0x8f, 0xce, 0x77,
+  0x4e, 0xf3, 0x94, 0xb9, 0xee, 0x09, 0xfa, 0x46, 0xbd, 0xb9, 0x37, 0xde, 0x6d, 0x3e, 0x13, 0x80,
+  0x17, 0x3a, 0x0b, 0x98, 0xde, 0x4e, 0x88, 0x20, 0xe9, 0xe4, 0xe2, 0x1e, 0x13, 0xa7, 0x13, 0xb3,
+  0xed, 0x87, 0x11, 0xe6, 0x47, 0x41, 0xb4, 0x65, 0x9e, 0x35, 0x34, 0x54, 0xbd, 0xd2, 0x52, 0x9f,
+  0x85, 0xaa, 0x71, 0x62, 0xa9, 0xb2, 0xa3, 0xcc, 0x95, 0x7c, 0xfe, 0xb1, 0x36, 0x93, 0x19, 0x80,
+  0x62, 0x5b, 0x84, 0xa8, 0x94, 0xec, 0xbb, 0x23, 0x48, 0xfd, 0x05, 0x7b, 0xa6, 0xba, 0xa3, 0x68,
+  0xff, 0xd1, 0xe1, 0xa1, 0x27, 0xfb, 0x20, 0x43, 0x1d, 0x4b, 0x5a, 0xc0, 0x45, 0x83, 0xe0, 0x6a,
+  0x8a, 0x6b, 0xf4, 0x05, 0x13, 0x21, 0x30, 0x80, 0x56, 0xb4, 0xbc, 0xf9, 0xd1, 0x78, 0x07, 0xad,
+  0xdf, 0xae, 0x98, 0xc7, 0x29, 0xe9, 0x95, 0x3a, 0xe1, 0xa7, 0x27, 0x90, 0xb6, 0xf7, 0x35, 0xba,
+  0x8d, 0x55, 0x79, 0x43, 0xf9, 0x0d, 0xf5, 0x75, 0x55, 0x76, 0x0f, 0x95, 0x6f, 0xd5, 0x39, 0x6c,
+  0x0d, 0x5e, 0xbd, 0xc9, 0xab, 0x57, 0x05, 0x4d, 0x34, 0x9b, 0xe2, 0x74, 0x1e, 0x79, 0x3d, 0x1e,
+  0x2b, 0x8b, 0x9e, 0x10, 0xc5, 0x79, 0x7b, 0xfa, 0xd6, 0xee, 0xde, 0xfe, 0xc4, 0xd5, 0xd5, 0xe5,
+  0x61, 0xba, 0x41, 0x74, 0x79, 0xa8, 0x36, 0xb1, 0x2e, 0x71, 0xbf, 0x26, 0xdd, 0x3b, 0xf2, 0xf8,
+  0x1d, 0xe1, 0xde, 0xb4, 0x53, 0xf8, 0xe0, 0x8d, 0x74, 0xc1, 0x0e, 0x99, 0x07, 0x34, 0x49, 0xca,
+  0x0f, 0x32, 0xe7, 0xcc, 0x2d, 0xa5, 0x73, 0xf5, 0x32, 0xbb, 0xbc, 0x3c, 0x04, 0x42, 0x8a, 0x64,
+  0x41, 0xb7, 0xa0, 0xa0, 0xf6, 0x4a, 0x3a, 0xc5, 0x1e, 0x55, 0xf9, 0xb9, 0x52, 0x52, 0xe9, 0xa1,
+  0x7c, 0x61, 0xe9, 0x5e, 0xfd, 0xcf, 0x7f, 0xfe, 0xeb, 0x7f, 0xfc, 0xf7, 0x7f, 0xfd, 0x1b, 0xb1,
+  0xed, 0x81, 0xc1, 0x2b, 0xd5, 0x31, 0x25, 0xa2, 0x8a, 0xd7, 0xce, 0x95, 0x7b, 0x46, 0x5e, 0x2e,
+  0x69, 0x88, 0x26, 0x76, 0xfd, 0xf2, 0xcb, 0xf3, 0x93, 0xb3, 0x71, 0x89, 0x04, 0x64, 0x98, 0x62,
+  0x49, 0xde, 0xde, 0x7e, 0x59, 0x62, 0x5f, 0x49, 0xac, 0xf2, 0xd5, 0xc8, 0x75, 0xd6, 0xff, 0xd6,
+  0xf9, 0x7e, 0xee, 0x38, 0x48, 0x91, 0xbc, 0x5b, 0x7b, 0x60, 0xb7, 0xc0, 0xb5, 0xea, 0x08, 0x3b,
+  0x8e, 0x9d, 0xd7, 0x52, 0xe7, 0x58, 0xa3, 0xa6, 0x24, 0x71, 0x04, 0x92, 0xf8, 0xf7, 0x7f, 0x21,
+  0x5f, 0xf1, 0x78, 0x05, 0x61, 0x89, 0x65, 0xa4, 0x7b, 0x30, 0x4d, 0x1f, 0xa4, 0x70, 0x64, 0x18,
+  0xa3, 0x51, 0x57, 0xf6, 0x64, 0x20, 0x2e, 0x5f, 0x56, 0x1d, 0x5b, 0x71, 0xbf, 0x66, 0xd3, 0x0e,
+  0xb6, 0x70, 0x3b, 0xd2, 0x22, 0xfc, 0x74, 0xba, 0xaf, 0xe4, 0x9d, 0x94, 0x58, 0xd1, 0xe1, 0xed,
+  0x10, 0x0a, 0x61, 0x78, 0x2d, 0xa6, 0x9d, 0xc1, 0x8c, 0x87, 0x1d, 0x72, 0x68, 0x21, 0x3e, 0xdb,
+  0x08, 0x01, 0xeb, 0x4f, 0xc7, 0x63, 0x72, 0x57, 0x0a, 0xaf, 0x1d, 0x12, 0x85, 0xf3, 0x00, 0xfc,
+  0x69, 0xda, 0x51, 0x2c, 0x66, 0x6b, 0xec, 0xf5, 0x15, 0x13, 0xea, 0xee, 0xef, 0x04, 0x08, 0xe6,
+  0x9d, 0xf2, 0x89, 0xec, 0x8d, 0xcb, 0x43, 0x45, 0xd9, 0xb0, 0xf8, 0xaa, 0xf6, 0x2a, 0x32, 0x41,
+  0x9a, 0x20, 0x10, 0xcd, 0xc6, 0x4b, 0xfd, 0xdd, 0xbc, 0x53, 0xda, 0xb9, 0xfa, 0x56, 0x36, 0x4c,
+  0x21, 0x88, 0x91, 0x4c, 0x14, 0x64, 0x23, 0x25, 0x6f, 0x9b, 0x20, 0x59, 0x21, 0x76, 0x4b, 0x67,
+  0x43, 0xfb, 0x48, 0x3b, 0xfe, 0x2a, 0xdf, 0x29, 0x52, 0x78, 0xb5, 0xd1, 0x53, 0xef, 0xff, 0x5a,
+  0xb4, 0x73, 0xc3, 0x02, 0x30, 0x0d, 0x42, 0x09, 0x8a, 0x99, 0xa0, 0xfc, 0xc1, 0x01, 0x57, 0x6b,
+  0x8e, 0xe1, 0x1a, 0x79, 0x93, 0xce, 0x31, 0x20, 0xaf, 0xe4, 0xa6, 0x32, 0x18, 0x34, 0x70, 0x10,
+  0xb3, 0x59, 0x14, 0x09, 0xb9, 0xc5, 0xb8, 0xa2, 0x82, 0x43, 0x69, 0x16, 0xdc, 0x13, 0xea, 0x43,
+  0x92, 0x4a, 0xd2, 0xdc, 0xc9, 0xdf, 0x04, 0xe9, 0x5a, 0x06, 0x06, 0xf1, 0xc9, 0x75, 0x68, 0xe6,
+  0x5a, 0x5f, 0xb2, 0xd5, 0x9c, 0x2b, 0xc0, 0xde, 0x69, 0x36, 0xce, 0x52, 0xdf, 0xcf, 0x66, 0x9d,
+  0xcb, 0xa3, 0x4c, 0xa4, 0xa6, 0xde, 0x9b, 0xbe, 0xb3, 0xd2, 0xb9, 0x92, 0x38, 0x91, 0x10, 0xd7,
+  0x39, 0x31, 0xfb, 0x46, 0xc5, 0x16, 0xe4, 0xfc, 0x89, 0x33, 0x74, 0xc6, 0x9d, 0x2b, 0x9b, 0x5a,
+  0xcd, 0xb7, 0xff, 0x8f, 0x96, 0x75, 0xea, 0xb8, 0xa3, 0xf6, 0xeb, 0x3a, 0x71, 0x5c, 0xf7, 0xff,
+  0xc9, 0xc2, 0xdc, 0x23, 0xc7, 0x3d, 0x6b, 0xbf, 0x32, 0x77, 0xe4, 0xb8, 0xa7, 0xfb, 0x2c, 0x6d,
+  0x1f, 0x0b, 0xae, 0x84, 0x78, 0x93, 0x05, 0x9b, 0x41, 0x2d, 0xad, 0xc2, 0x4a, 0xa0, 0x96, 0x30,
+  0xf1, 0x65, 0x10, 0xa8, 0x15, 0xf6, 0xce, 0x87, 0x7d, 0x88, 0x98, 0xb2, 0xd2, 0x26, 0x70, 0xb7,
+  0x01, 0xc0, 0xcc, 0xe4, 0xf3, 0xf2, 0xca, 0x36, 0x01, 0xd2, 0xff, 0x13, 0x80, 0xc4, 0x75, 0x9a,
+  0x2f, 0x3f, 0xfd, 0x0c, 0xee, 0x99, 0x9c, 0x83, 0x7e, 0x7c, 0xc4, 0x1c, 0x0a, 0x81, 0x14, 0xbc,
+  0x27, 0x5b, 0xc6, 0xd6, 0x88, 0xee, 0xa5, 0xf9, 0xf0, 0x16, 0xcc, 0x08, 0x11, 0xe0, 0xea, 0x06,
+  0xaf, 0xc9, 0x2d, 0x4b, 0xc4, 0xde, 0xd3, 0xd4, 0x75, 0xb1, 0x60, 0x22, 0x63, 0x3a, 0x41, 0xe2,
+  0xdf, 0x32, 0x3f, 0x66, 0xc9, 0xd2, 0x4c, 0x39, 0xb5, 0x96, 0x67, 0x9f, 0x11, 0xc8, 0x20, 0x90,
+  0x84, 0xde, 0xbb, 0xb5, 0xe4, 0x1f, 0x2f, 0x21, 0x5c, 0x9b, 0xe6, 0x68, 0x4f, 0x8f, 0x8b, 0x57,
+  0xd1, 0x36, 0x94, 0xf4, 0xb8, 0x20, 0x78, 0xbd, 0x07, 0x3d, 0x93, 0x4a, 0x63, 0x08, 0x29, 0x50,
+  0x5b, 0xa4, 0x42, 0xfe, 0x56, 0x7d, 0x2b, 0x68, 0x9a, 0xd2, 0xa0, 0xb2, 0x3c, 0x2e, 0x93, 0x79,
+  0xcc, 0xd7, 0xa2, 0x98, 0x3c, 0x60, 0x82, 0x28, 0xb7, 0x24, 0x53, 0xf2, 0xe9, 0xe1, 0xa2, 0xfa,
+  0x00, 0x75, 0x88, 0x95, 0xf4, 0x94, 0xf8, 0x34, 0x28, 0x57, 0x34, 0xf9, 0xd3, 0xaf, 0xa3, 0x19,
+  0x3c, 0x1d, 0x1a, 0x9e, 0xdc, 0x30, 0x16, 0x9a, 0x07, 0x6e, 0x71, 0xae, 0x70, 0x13, 0x04, 0xc5,
+  0x6d, 0x58, 0x68, 0x22, 0x08, 0x2c, 0x5f, 0xbc, 0xf6, 0x40, 0x50, 0x55, 0x56, 0xf2, 0x8b, 0xc3,
+  0x43, 0x72, 0xcd, 0xe2, 0x84, 0x27, 0xd8, 0xf9, 0xc2, 0x53, 0x5c, 0x98, 0x1b, 0x4e, 0x88, 0x6a,
+  0x49, 0x26, 0x00, 0x5d, 0x10, 0xfd, 0x57, 0xd8, 0x3e, 0x3f, 0x20, 0x02, 0x24, 0xb3, 0x62, 0x22,
+  0xbe, 0x4f, 0xef, 0x26, 0x84, 0x87, 0x39, 0x1d, 0x7f, 0x13, 0xaa, 0xcc, 0x2e, 0x4d, 0x87, 0x6f,
+  0x20, 0xaa, 0x33, 0xd1, 0xd3, 0xcb, 0x1c, 0xc5, 0x27, 0xdb, 0x92, 0x3f, 0xb3, 0x59, 0xfa, 0xca,
+  0xfb, 0x6d, 0x32, 0x39, 0x3c, 0xfc, 0xd5, 0x27, 0xc8, 0x03, 0x28, 0x52, 0x18, 0x2c, 0xa3, 0x44,
+  0xe0, 0x99, 0xb1, 0x87, 0xc9, 0x99, 0x7b, 0xf8, 0x5e, 0x2b, 0xf2, 0xb7, 0x09, 0x06, 0x7e, 0x50,
+  0xe0, 0x2d, 0xe4, 0x67, 0x40, 0xab, 0x4b, 0xe3, 0x98, 0xde, 0xcf, 0x36, 0xbe, 0xcf, 0xe2, 0x6e,
+  0xed, 0xd5, 0x28, 0x8c, 0xd6, 0x52, 0x64, 0xc0, 0xc8, 0xf4, 0x2a, 0x8d, 0xf1, 0x2f, 0xb5, 0xdc,
+  0xbe, 0x27, 0xe2, 0x0d, 0xeb, 0x1b, 0xc6, 0xce, 0x83, 0x28, 0x61, 0xf9, 0xe0, 0x7a, 0xf5, 0x61,
+  0x21, 0x27, 0xd5, 0xa3, 0xd1, 0xc3, 0x1f, 0x80, 0x8e, 0x5b, 0xbe, 0x62, 0x20, 0xcb, 0x5e, 0x45,
+  0x48, 0x07, 0xb8, 0xdf, 0x3f, 0xd4, 0x06, 0x3c, 0x18, 0xf8, 0x59, 0x01, 0x50, 0xd0, 0x05, 0x72,
+  0xc4, 0xee, 0x50, 0x5b, 0x46, 0xa6, 0xb8, 0x4f, 0x7a, 0x98, 0xbb, 0x46, 0xbe, 0x7a, 0x6b, 0x00,
+  0x3c, 0x52, 0x32, 0x9d, 0x82, 0xa8, 0x40, 0x6d, 0x60, 0x79, 0xdd, 0xbe, 0x61, 0x54, 0xba, 0x61,
+  0x10, 0xdc, 0xdf, 0x66, 0x4a, 0xee, 0x7d, 0x7d, 0xf3, 0xf6, 0x9b, 0xc1, 0x1a, 0x4f, 0xf5, 0xf5,
+  0x0a, 0x42, 0x7d, 0xc3, 0xba, 0x1e, 0x6c, 0x8c, 0x3f, 0x18, 0xcd, 0x0d, 0x80, 0x46, 0xa6, 0x70,
+  0x62, 0xc9, 0x48, 0x1c, 0x41, 0x34, 0xec, 0x26, 0x90, 0xa2, 0x51, 0xcc, 0x14, 0x31, 0x8d, 0x5f,
+  0x6f, 0x92, 0x25, 0xe4, 0x72, 0xb3, 0x7b, 0xf9, 0xc2, 0x3c, 0x2f, 0x4e, 0xea, 0x96, 0xa6, 0xf1,
+  0x2b, 0xf4, 0x75, 0x49, 0x49, 0x0c, 0x50, 0x16, 0xe4, 0x39, 0x2e, 0x3f, 0xb7, 0x5f, 0x90, 0x40,
+  0xcc, 0xc4, 0x26, 0x0e, 0xf5, 0x4e, 0x06, 0x3a, 0x4c, 0x18, 0x6d, 0x41, 0xc0, 0xaf, 0x30, 0x17,
+  0x84, 0xcb, 0x5e, 0x5f, 0xef, 0x69, 0xc4, 0xa4, 0x87, 0x0e, 0xc7, 0xa5, 0x8b, 0xc2, 0xc7, 0x25,
+  0x11, 0x83, 0xac, 0x23, 0x93, 0x0c, 0x02, 0x16, 0x2e, 0xc4, 0x12, 0xee, 0x7f, 0xf1, 0x85, 0x49,
+  0xcc, 0xb0, 0xfc, 0x3f, 0x32, 0x7a, 0xc7, 0x20, 0x7f, 0x4d, 0xb7, 0xc5, 0x68, 0x10, 0x85, 0x0c,
+  0xbb, 0x27, 0x90, 0xc8, 0xe2, 0x82, 0x37, 0x80, 0x1c, 0x84, 0x27, 0xc4, 0x8b, 0xe9, 0x62, 0x81,
+  0x38, 0xc1, 0x85, 0x51, 0xc5, 0xc8, 0xa6, 0x03, 0xac, 0xa4, 0xee, 0xfd, 0x1d, 0xff, 0x9e, 0xfc,
+  0xed, 0x6f, 0x64, 0xd8, 0x07, 0x7e, 0xc6, 0x60, 0x4c, 0x52, 0x70, 0x3c, 0xdc, 0xb0, 0xba, 0xba,
+  0xbc, 0x68, 0xbe, 0x59, 0xa1, 0x3e, 0x21, 0x02, 0xbc, 0x46, 0x89, 0x84, 0xe2, 0x77, 0xf7, 0x6f,
+  0xbc, 0xde, 0x7b, 0x95, 0xcc, 0xfc, 0xea, 0x13, 0x7f, 0x78, 0xdf, 0x1f, 0xa8, 0x5d, 0xcb, 0x69,
+  0x79, 0x71, 0x30, 0xc7, 0x1e, 0xd4, 0x24, 0x81, 0x8c, 0x1a, 0xee, 0x1c, 0xbe, 0x54, 0xdd, 0xf5,
+  0x1a, 0x4d, 0xf2, 0x05, 0xe9, 0xfe, 0xe3, 0xef, 0x5d, 0x93, 0xbf, 0x20, 0x86, 0xe2, 0x1b, 0xcd,
+  0x6c, 0x34, 0x74, 0x0f, 0x40, 0xde, 0xb7, 0x20, 0x54, 0x09, 0x9e, 0x28, 0x55, 0xd9, 0x5e, 0x04,
+  0xc7, 0x66, 0x20, 0xd6, 0x84, 0xfc, 0x00, 0x40, 0x9b, 0x40, 0xc5, 0x91, 0x90, 0x19, 0x43, 0x51,
+  0xa3, 0xfc, 0x31, 0xcb, 0x01, 0xfd, 0x80, 0x52, 0x6a, 0xb6, 0x94, 0x43, 0xf7, 0x6f, 0x7e, 0x03,
+  0xfc, 0xe0, 0x60, 0xf4, 0xaa, 0x0c, 0xb2, 0x4d, 0xea, 0x2e, 0x83, 0x36, 0x82, 0x8c, 0xc6, 0x37,
+  0x61, 0x00, 0x14, 0x35, 0xd2, 0xbd, 0x62, 0x14, 0x68, 0x54, 0x0c, 0x50, 0xc5, 0xaf, 0x80, 0x9f,
+  0xaf, 0xf5, 0x09, 0x4d, 0x33, 0xb2, 0xd0, 0x93, 0x59, 0x82, 0x6e, 0xb7, 0x0d, 0x32, 0xc2, 0xf9,
+  0x6d, 0x5a, 0xec, 0xe6, 0x05, 0x67, 0xb7, 0x3f, 0xc8, 0xda, 0xa2, 0xa6, 0x79, 0xad, 0x04, 0xf2,
+  0xea, 0xb2, 0x5b, 0xb7, 0x02, 0x78, 0xd6, 0xdc, 0xaa, 0xd1, 0xa1, 0xe3, 0x8d, 0x3a, 0x1c, 0xcc,
+  0x7f, 0x64, 0xca, 0x38, 0x32, 0x78, 0x48, 0xea, 0xe0, 0x80, 0xe7, 0x88, 0xd3, 0xce, 0x46, 0x52,
+  0x8b, 0x42, 0xca, 0xd3, 0x65, 0xda, 0x8e, 0xf1, 0xe8, 0xbb, 0xda, 0x72, 0x3e, 0x91, 0xbc, 0x4b,
+  0x33, 0x01, 0xdc, 0xcc, 0xab, 0xa2, 0xee, 0x01, 0xa2, 0x54, 0x2c, 0x26, 0x64, 0x78, 0x80, 0xb2,
+  0x9e, 0x90, 0x31, 0x79, 0x38, 0x68, 0x37, 0x1c, 0x8b, 0x8f, 0x62, 0xfc, 0x49, 0x3a, 0xde, 0x75,
+  0x5b, 0x13, 0x90, 0x39, 0x7e, 0x41, 0xc1, 0x1d, 0x65, 0x24, 0x4e, 0x35, 0xf5, 0x6a, 0xfe, 0xa1,
+  0x9d, 0xe2, 0xc1, 0x45, 0x0f, 0x00, 0xc7, 0x5e, 0xd3, 0xf9, 0xb2, 0xa7, 0x4e, 0xcf, 0x18, 0x03,
+  0x89, 0x12, 0x52, 0x71, 0xb2, 0x77, 0x6a, 0x55, 0xb2, 0x24, 0x52, 0x9c, 0x01, 0x36, 0x84, 0x88,
+  0x0a, 0x6c, 0xaa, 0xd7, 0xe5, 0x2a, 0x24, 0x80, 0x66, 0x77, 0x60, 0x31, 0x56, 0xe0, 0x2c, 0x18,
+  0x92, 0xc2, 0x78, 0x05, 0xc5, 0x49, 0x89, 0x9f, 0x39, 0xc4, 0x0f, 0xc1, 0x52, 0x96, 0x7a, 0x5d,
+  0xc8, 0xcd, 0xba, 0x06, 0x26, 0x72, 0x4c, 0x81, 0xd1, 0x03, 0x99, 0x17, 0x7e, 0x03, 0x59, 0x06,
+  0xe6, 0x10, 0x95, 0x13, 0x2e, 0xdd, 0x1d, 0x23, 0x39, 0x84, 0xee, 0xf8, 0x0f, 0xb7, 0x7f, 0xfa,
+  0x23, 0x8c, 0x7c, 0x6f, 0x7c, 0xd5, 0x5c, 0x25, 0xca, 0x33, 0x2f, 0x96, 0x2a, 0xb1, 0xe8, 0x99,
+  0xac, 0x69, 0xa8, 0x4a, 0x40, 0x02, 0xd0, 0x09, 0xd0, 0xe8, 0x3e, 0x5c, 0x1e, 0xca, 0x9b, 0xbb,
+  0xc7, 0x55, 0xa7, 0x93, 0xf8, 0xab, 0xca, 0x8a, 0x02, 0x8a, 0x3b, 0x57, 0xe7, 0xc3, 0x7f, 0xfc,
+  0x7d, 0x17, 0x45, 0x4b, 0x15, 0x69, 0x6c, 0x90, 0xc9, 0xed, 0xea, 0x4e, 0x75, 0x6a, 0x15, 0xda,
+  0x3a, 0x45, 0x7d, 0xaa, 0xe6, 0x26, 0x8d, 0x4b, 0x50, 0x87, 0x4f, 0xa6, 0x9d, 0x61, 0x07, 0x4f,
+  0x8d, 0x4f, 0x3b, 0x50, 0x5b, 0x75, 0x88, 0xe4, 0x7c, 0xda, 0x39, 0x1f, 0xee, 0x1e, 0x1c, 0x85,
+  0x92, 0x2d, 0xec, 0x91, 0x61, 0x56, 0x26, 0x65, 0xd8, 0xc3, 0x79, 0x21, 0x71, 0x5d, 0xf2, 0x44,
+  0x05, 0xb4, 0xbe, 0x45, 0xfe, 0xef, 0x2f, 0x6c, 0x16, 0xa7, 0x4c, 0x7a, 0x80, 0x87, 0x29, 0x42,
+  0xef, 0x25, 0x84, 0x69, 0xaf, 0x97, 0x59, 0x42, 0x93, 0x89, 0xa5, 0x61, 0xeb, 0x7c, 0xb8, 0x33,
+  0x5d, 0xea, 0xef, 0xca, 0x97, 0x54, 0xf7, 0x54, 0x36, 0xfb, 0x32, 0x74, 0xab, 0xc3, 0x9d, 0xde,
+  0x2e, 0x34, 0x02, 0x1e, 0x76, 0xcb, 0xde, 0x48, 0xdd, 0xd9, 0x7d, 0xb9, 0x5b, 0xee, 0x73, 0x76,
+  0xfb, 0xa6, 0x0c, 0x29, 0x8f, 0x09, 0x4d, 0x64, 0x4a, 0x81, 0xc3, 0x44, 0x43, 0xb5, 0x17, 0x35,
+  0x37, 0x6e, 0x88, 0x1d, 0x17, 0xcd, 0xf1, 0xeb, 0x79, 0xbe, 0x34, 0x79, 0xe8, 0x36, 0xf9, 0x6e,
+  0xf8, 0xbd, 0x09, 0x45, 0x28, 0xe4, 0x91, 0x80, 0x0f, 0xd7, 0xb2, 0xc2, 0x03, 0x45, 0xa5, 0xad,
+  0xc4, 0xbc, 0x9f, 0x29, 0xdb, 0x89, 0xf0, 0x2d, 0x11, 0x26, 0xfc, 0x30, 0xe5, 0x8c, 0x0d, 0x71,
+  0xb5, 0x90, 0x39, 0x96, 0x6c, 0x35, 0xfe, 0x2e, 0xcc, 0x8b, 0x18, 0x60, 0xe5, 0x83, 0x50, 0x98,
+  0xfc, 0x99, 0x8b, 0x65, 0xaf, 0x8b, 0xd5, 0x4e, 0xb7, 0xbf, 0xc7, 0x62, 0xc0, 0xce, 0xb9, 0x97,
+  0x75, 0x47, 0x4b, 0xeb, 0x7a, 0x82, 0x15, 0xe5, 0x3a, 0xcd, 0x53, 0x01, 0x63, 0x5e, 0x53, 0xbc,
+  0x56, 0x0d, 0xf8, 0x5d, 0x65, 0xc5, 0x90, 0xe6, 0x0c, 0x06, 0x03, 0x0d, 0x65, 0x73, 0x7b, 0xa8,
+  0x02, 0xb3, 0xd6, 0x89, 0xce, 0xce, 0xdd, 0x5a, 0x07, 0xdb, 0x26, 0xcc, 0x45, 0x51, 0x9f, 0xd9,
+  0xa4, 0xb3, 0x28, 0x5e, 0xbd, 0x92, 0x55, 0x93, 0x2c, 0x55, 0xbf, 0x4a, 0xbf, 0x1a, 0x6a, 0x01,
+  0x79, 0x3f, 0x05, 0x87, 0xc2, 0x75, 0x20, 0x46, 0xa3, 0xc4, 0x9b, 0x8c, 0xd6, 0x67, 0x02, 0xa2,
+  0x6f, 0xf7, 0x50, 0x81, 0x15, 0x0c, 0xa8, 0xeb, 0x17, 0x4a, 0x95, 0x65, 0x04, 0xe1, 0xbd, 0x7b,
+  0xfd, 0xf6, 0xe6, 0xb6, 0x5b, 0xcf, 0x11, 0x70, 0xd7, 0x6a, 0x92, 0x33, 0xa1, 0x81, 0x4a, 0x75,
+  0x0f, 0x0d, 0x12, 0xdb, 0xb0, 0x07, 0x82, 0x5b, 0xc3, 0xf2, 0x98, 0xbd, 0x6c, 0xcc, 0xde, 0x18,
+  0x44, 0x1f, 0x6c, 0x31, 0xb8, 0x9d, 0x9e, 0xd2, 0xa6, 0x96, 0x2d, 0x92, 0x36, 0xab, 0xab, 0xd4,
+  0x94, 0x7f, 0x9e, 0xf5, 0xf1, 0x79, 0x92, 0x76, 0xf1, 0x8d, 0xc6, 0x63, 0x28, 0xb0, 0x6d, 0x25,
+  0x7b, 0xde, 0x33, 0xc9, 0x9a, 0x0d, 0x31, 0xc3, 0x39, 0x7b, 0x16, 0x2c, 0x87, 0xe0, 0x31, 0xae,
+  0xd7, 0xe6, 0xa5, 0xe4, 0xdd, 0x3c, 0x83, 0x58, 0xc6, 0x50, 0x9e, 0xa1, 0xed, 0xbc, 0xc6, 0xa3,
+  0xde, 0xbd, 0x6c, 0x65, 0x3e, 0xc5, 0x7d, 0x8a, 0xee, 0xee, 0x1a, 0x5a, 0xd3, 0x1f, 0xf0, 0x0a,
+  0xd6, 0xa2, 0x8e, 0x8d, 0x5b, 0x73, 0xb5, 0x08, 0xc0, 0x83, 0x55, 0xa6, 0x93, 0xdf, 0x26, 0x60,
+  0x5c, 0xf2, 0xc2, 0xd4, 0x91, 0x68, 0xa5, 0x4d, 0x39, 0xba, 0xdb, 0x34, 0xda, 0xac, 0x47, 0xb5,
+  0xda, 0x01, 0x49, 0x11, 0x0a, 0x1b, 0x47, 0x74, 0x01, 0xe1, 0xd4, 0xa4, 0x3e, 0x23, 0xb4, 0x68,
+  0x7d, 0xae, 0x96, 0xf8, 0x92, 0x6f, 0x89, 0x69, 0xd3, 0xec, 0x8e, 0xb4, 0xe9, 0x46, 0x22, 0x0f,
+  0x21, 0xfd, 0xe1, 0xde, 0x06, 0x5b, 0x12, 0x18, 0xcb, 0x4d, 0xd1, 0xb6, 0x48, 0x31, 0xe4, 0x2b,
+  0x6f, 0xbc, 0x03, 0x02, 0x89, 0x10, 0xf8, 0xbc, 0x7e, 0x52, 0x6d, 0x57, 0x79, 0x9c, 0x0e, 0xaf,
+  0x17, 0xc9, 0x92, 0x9c, 0xb1, 0x36, 0x4e, 0x13, 0x8c, 0x74, 0x24, 0xa6, 0x19, 0xb2, 0x4b, 0xf3,
+  0x06, 0x52, 0x5f, 0xc5, 0x43, 0xf5, 0xf5, 0xbc, 0x45, 0x50, 0x1a, 0x60, 0x6b, 0x6f, 0xe8, 0xc5,
+  0xf3, 0x4d, 0xda, 0xfe, 0xc3, 0xb2, 0x19, 0xab, 0xe3, 0xbc, 0x6b, 0x47, 0xb6, 0x00, 0x29, 0x50,
+  0x44, 0xa3, 0x67, 0x6e, 0xd6, 0x17, 0xa8, 0xaa, 0x40, 0x9e, 0x8d, 0x20, 0x22, 0x22, 0x7f, 0xb8,
+  0xbd, 0xbd, 0xae, 0x45, 0xb7, 0x6d, 0x82, 0xc5, 0xed, 0x36, 0x19, 0xc8, 0xed, 0xc4, 0x1b, 0xd9,
+  0xeb, 0xc1, 0x72, 0x36, 0x27, 0x39, 0x78, 0x7b, 0xfd, 0xfa, 0x1b, 0x13, 0xee, 0xc0, 0x98, 0x04,
+  0xf1, 0x15, 0xfd, 0xe9, 0x1d, 0x0f, 0xc5, 0xd9, 0x97, 0xd8, 0xf2, 0xeb, 0x7d, 0xe7, 0x1e, 0x90,
+  0x5c, 0xf8, 0x9a, 0x04, 0xbe, 0xef, 0x3f, 0x3e, 0xda, 0x65, 0x10, 0x0d, 0xa8, 0x22, 0x35, 0xfd,
+  0x59, 0x20, 0xad, 0x36, 0xf3, 0x93, 0x09, 0x54, 0x74, 0xdd, 0x54, 0xb7, 0x0e, 0x76, 0x2e, 0xbb,
+  0x30, 0x04, 0xfb, 0x57, 0x5c, 0xc1, 0xd0, 0xe1, 0x0f, 0x49, 0x14, 0x76, 0x4d, 0x95, 0xa0, 0x42,
+  0x79, 0xd9, 0x8b, 0x53, 0xed, 0x3b, 0xee, 0xdf, 0xf7, 0x3e, 0xa9, 0x85, 0x4f, 0x48, 0xd5, 0xf8,
+  0x26, 0xba, 0x18, 0x74, 0x20, 0x79, 0xe8, 0x17, 0x50, 0xd2, 0x0a, 0x48, 0x24, 0x7c, 0x21, 0xae,
+  0x22, 0xf0, 0xa6, 0x93, 0x2a, 0x3c, 0xe9, 0x5f, 0x3c, 0xa6, 0x1d, 0xba, 0xdb, 0x17, 0x6f, 0xc0,
+  0xc6, 0xe4, 0xf6, 0xb1, 0x6a, 0xa4, 0x83, 0x55, 0x25, 0x88, 0x4e, 0x59, 0x17, 0xa8, 0xee, 0x93,
+  0x95, 0x8d, 0x19, 0xa3, 0x2f, 0x96, 0x1b, 0x2d, 0xe6, 0x0e, 0xe0, 0xce, 0x56, 0x9f, 0x7b, 0x66,
+  0xad, 0x50, 0xf7, 0x6b, 0xab, 0x49, 0x06, 0x9f, 0xa6, 0x9b, 0x66, 0x07, 0x0a, 0xbd, 0x1a, 0x31,
+  0x4c, 0xda, 0xce, 0xfe, 0x41, 0xb0, 0xbf, 0x28, 0xeb, 0x4f, 0xad, 0x5d, 0xad, 0xfc, 0x69, 0x6d,
+  0xbc, 0xb0, 0xb9, 0x9f, 0xcb, 0xd0, 0x65, 0x6f, 0x52, 0xb0, 0x44, 0x5c, 0x94, 0x76, 0x58, 0x68,
+  0xc8, 0x57, 0x30, 0x47, 0x22, 0x51, 0x37, 0xdb, 0x8c, 0xa1, 0x49, 0xd1, 0x34, 0x27, 0x2b, 0x00,
+  0xe5, 0xa2, 0xef, 0x45, 0x93, 0xfb, 0x70, 0x5e, 0x72, 0x86, 0x7c, 0xd7, 0x70, 0x6f, 0x1f, 0x28,
+  0x6d, 0x50, 0xd5, 0x53, 0x7b, 0x43, 0xb2, 0x3c, 0x6b, 0xae, 0x03, 0xb3, 0x2d, 0x4d, 0x3d, 0xe9,
+  0x99, 0xd5, 0xc3, 0xf7, 0x4d, 0x3a, 0x73, 0x3d, 0xc1, 0x9b, 0xed, 0x2a, 0x39, 0xb4, 0xd3, 0x83,
+  0xf7, 0xd6, 0x76, 0x56, 0x91, 0x04, 0x13, 0xba, 0xa5, 0x10, 0xbf, 0x72, 0x2b, 0xc7, 0xc9, 0xd1,
+  0xc8, 0x35, 0xa3, 0xae, 0x68, 0xb0, 0x4a, 0x4b, 0x6d, 0xac, 0xa4, 0x74, 0xf2, 0xdc, 0x19, 0x6d,
+  0xd9, 0x94, 0x4e, 0x96, 0xb6, 0xf6, 0x70, 0xa0, 0xec, 0x1f, 0x63, 0xc7, 0xfe, 0xa2, 0xb1, 0x6b,
+  0x6c, 0x49, 0x81, 0xc0, 0x6e, 0xb0, 0x3c, 0x8c, 0xb0, 0x0d, 0x93, 0xdb, 0x0c, 0xd8, 0x46, 0x2c,
+  0x53, 0xe5, 0x30, 0x12, 0x4b, 0xd9, 0xcf, 0x8e, 0x88, 0x5a, 0x63, 0x14, 0x1b, 0xf3, 0xfd, 0xe7,
+  0xa5, 0x84, 0x1f, 0x79, 0x79, 0x0e, 0x31, 0x1a, 0x3e, 0xaa, 0x31, 0xfa, 0x79, 0xab, 0x18, 0xdd,
+  0xd4, 0x7b, 0x36, 0xe4, 0xb7, 0x44, 0xba, 0x28, 0x41, 0x1f, 0xed, 0xef, 0xf6, 0x50, 0xe5, 0x22,
+  0xe5, 0x6c, 0xf6, 0x71, 0x4e, 0xd9, 0xae, 0x51, 0x6e, 0x70, 0xd7, 0xdc, 0xbf, 0x8a, 0xd1, 0xc6,
+  0x46, 0xcb, 0x13, 0xfb, 0x84, 0xdc, 0xf2, 0x6f, 0x76, 0x09, 0x83, 0x9d, 0xd8, 0x77, 0x9a, 0xcd,
+  0x40, 0xf4, 0x7b, 0x08, 0x75, 0xf3, 0x4d, 0x1c, 0xe3, 0xcc, 0xf9, 0x66, 0x4b, 0x7d, 0xe9, 0xd5,
+  0x73, 0x03, 0xfa, 0x1f, 0x36, 0xa7, 0xde, 0x54, 0x7e, 0xa9, 0xdb, 0xaf, 0x09, 0xbf, 0x5e, 0x90,
+  0x6a, 0xee, 0x63, 0x1b, 0xa2, 0x5c, 0xce, 0x56, 0xd8, 0xed, 0x19, 0xb1, 0xab, 0x3a, 0x53, 0xc1,
+  0x24, 0x75, 0xce, 0xe6, 0x3d, 0xaf, 0x27, 0x0d, 0xf9, 0x3f, 0x5d, 0xe8, 0x6f, 0x99, 0x02, 0x98,
+  0x5d, 0x74, 0x87, 0x5b, 0x19, 0xb6, 0xcc, 0x0d, 0x85, 0x6b, 0xb5, 0x78, 0xb5, 0x2b, 0xce, 0x18,
+  0x91, 0x17, 0x69, 0x44, 0xce, 0x75, 0x61, 0xf7, 0xfd, 0xcf, 0xf0, 0xff, 0xd6, 0xd5, 0x60, 0x71,
+  0xe0, 0x37, 0x2d, 0x78, 0x6d, 0xe5, 0x60, 0x6d, 0xea, 0xfc, 0x60, 0xb0, 0x19, 0x24, 0xd2, 0x0a,
+  0xbb, 0x01, 0x27, 0xf4, 0x43, 0xc8, 0x3a, 0x5e, 0x20, 0x86, 0x5b, 0x27, 0x29, 0x2a, 0x74, 0x1d,
+  0x53, 0xf2, 0x53, 0xca, 0xd6, 0x9a, 0xbe, 0xda, 0x0e, 0x68, 0x38, 0xf2, 0xdc, 0x35, 0xee, 0x68,
+  0xb6, 0x65, 0xe4, 0x55, 0xe9, 0x98, 0xfd, 0x67, 0xf3, 0xe2, 0xd9, 0x89, 0x94, 0xb1, 0xdc, 0x50,
+  0x30, 0x64, 0x07, 0x93, 0x4a, 0xfc, 0xe6, 0xd9, 0x00, 0x3e, 0xeb, 0xf6, 0x15, 0x2e, 0xbe, 0xbe,
+  0x05, 0x78, 0xfa, 0xeb, 0x06, 0x30, 0xf8, 0xd9, 0x67, 0x00, 0x58, 0x13, 0x70, 0x29, 0x43, 0xc8,
+  0x0d, 0xbc, 0x86, 0x3e, 0xbb, 0xcf, 0x1e, 0xb4, 0x3e, 0x79, 0xb0, 0x1f, 0x56, 0x3d, 0xfd, 0x9e,
+  0xff, 0xde, 0x3b, 0xfe, 0x6d, 0xf7, 0xfb, 0xdb, 0x01, 0x54, 0x09, 0x98, 0x9a, 0x00, 0x49, 0x4f,
+  0x3c, 0xe4, 0x81, 0xb5, 0x86, 0xc4, 0xa3, 0x25, 0xe8, 0x54, 0xc1, 0xc6, 0x60, 0x8a, 0xd9, 0x99,
+  0x36, 0x4b, 0x38, 0x85, 0xe7, 0x0d, 0xc6, 0xf8, 0x13, 0x47, 0xd5, 0xfd, 0x8c, 0xf4, 0x49, 0x8c,
+  0xf5, 0xa7, 0x30, 0xda, 0x9f, 0xdc, 0x78, 0xf7, 0x33, 0xe2, 0x5f, 0x5e, 0xd4, 0xcd, 0x4e, 0x53,
+  0xee, 0x4a, 0xb4, 0x1f, 0x1d, 0x6c, 0xab, 0xd5, 0x2f, 0xc7, 0x42, 0x80, 0xdd, 0x31, 0x3c, 0x56,
+  0x28, 0xf7, 0xbd, 0xa1, 0xa8, 0xc1, 0x2d, 0xca, 0xc8, 0xf7, 0x2f, 0x64, 0xb9, 0x1b, 0x82, 0x2a,
+  0x64, 0xb5, 0x4b, 0xbc, 0x98, 0xdf, 0xa9, 0x92, 0x78, 0xa5, 0x3a, 0xc9, 0x75, 0x4f, 0x2a, 0x9f,
+  0xe5, 0xb4, 0x38, 0x53, 0xfa, 0x8a, 0xb9, 0xd6, 0x7b, 0x7a, 0xa7, 0xb2, 0x88, 0x4a, 0xfa, 0x50,
+  0x96, 0x02, 0xc8, 0xc3, 0x79, 0xe9, 0x9e, 0x49, 0xff, 0x49, 0x94, 0x99, 0x9e, 0x62, 0xfd, 0x59,
+  0x75, 0x59, 0x3a, 0x9d, 0x03, 0x9a, 0xc0, 0x56, 0x7c, 0xfe, 0x74, 0xcb, 0x43, 0x2f, 0xda, 0x0e,
+  0xa2, 0x50, 0x36, 0xe8, 0xa7, 0xb9, 0xbe, 0xea, 0xfd, 0x89, 0xca, 0xb1, 0x1d, 0xed, 0x4f, 0xbb,
+  0x2b, 0x95, 0x47, 0x6d, 0x57, 0xb9, 0x7c, 0xea, 0xb4, 0xc4, 0xe2, 0x45, 0xf6, 0x47, 0x5f, 0xe9,
+  0x29, 0xdd, 0xcb, 0x43, 0xf5, 0xe7, 0x5e, 0x97, 0x87, 0xea, 0x7f, 0x6d, 0xf8, 0xbf, 0x32, 0x75,
+  0x7e, 0xa9, 0xeb, 0x50, 0x00, 0x00,
+};
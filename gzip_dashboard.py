@@ -0,0 +1,50 @@
+"""Precompress dashboard.html into dashboard_html_gz.h for the firmware.
+
+Run after every change to dashboard.html:
+
+    python3 gzip_dashboard.py
+
+The header holds the gzip stream as a PROGMEM byte array plus a strong ETag
+derived from its contents. The script round-trips the stream and refuses to
+write the header if the decompressed bytes differ from the source.
+"""
+import gzip
+import hashlib
+import os
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(HERE, "dashboard.html")
+HEADER = os.path.join(HERE, "dashboard_html_gz.h")
+
+
+def main():
+    with open(SOURCE, "rb") as f:
+        html = f.read()
+
+    # mtime=0 keeps the output (and so the ETag) identical across rebuilds
+    packed = gzip.compress(html, compresslevel=9, mtime=0)
+    if gzip.decompress(packed) != html:
+        raise SystemExit("gzip round trip does not match dashboard.html")
+
+    etag = hashlib.sha256(packed).hexdigest()[:16]
+
+    lines = []
+    for i in range(0, len(packed), 16):
+        lines.append("  " + ", ".join("0x%02x" % b for b in packed[i:i + 16]) + ",")
+
+    with open(HEADER, "w") as f:
+        f.write("// Generated by gzip_dashboard.py from dashboard.html; do not edit.\n")
+        f.write("#pragma once\n\n")
+        f.write("#define DASHBOARD_ETAG \"\\\"%s\\\"\"\n\n" % etag)
+        f.write("const size_t dashboard_html_gz_len = %d;\n" % len(packed))
+        f.write("const uint8_t dashboard_html_gz[] PROGMEM = {\n")
+        f.write("\n".join(lines))
+        f.write("\n};\n")
+
+    saved = len(html) - len(packed)
+    print("dashboard.html: %d bytes -> %d bytes gzip (%d saved, %.1f%%), ETag %s"
+          % (len(html), len(packed), saved, 100.0 * saved / len(html), etag))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,120 @@
+// Host harness for Hexapod_Basic_v1.cpp. The sketch is built unchanged
+// against the stand-ins in host/include, twice: hexapod_host with
+// MOTION_TASK 0, so the motion tick runs from loop(), and hexapod_host_task
+// with the motion task on its own thread as on the robot. Tests drive it
+// through the calls below and read back what reached the I2C bus.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Clock
+
+// Simulated time since boot. delay() advances it; nothing else does.
+// Tasks due on the way run first, each up to its next vTaskDelayUntil().
+uint64_t hostNowUs();
+void hostAdvanceUs(uint64_t us);
+
+// Follow the wall clock instead: delay() sleeps and tasks run
+// concurrently with loop() (the simulator does this)
+void hostSetRealtime(bool realtime);
+
+// Boot and run
+
+// Run setup() once
+void hostBoot();
+
+// Run loop() until the simulated clock has moved on by ms
+void hostRun(uint32_t ms);
+
+// Set by ESP.restart()
+bool hostRestartRequested();
+
+// I2C bus
+
+struct HostI2cTransaction {
+  uint64_t timeUs;
+  uint8_t address;
+  uint8_t result;          // endTransmission() status, 2 = address NACK
+  std::vector<uint8_t> data;
+};
+
+// One PCA9685 channel's ON/OFF pair as left by a write. All-call and
+// ALL_LED writes show up once per board and channel they reach.
+struct HostChannelWrite {
+  uint64_t timeUs;
+  uint8_t address;
+  uint8_t channel;
+  uint16_t on;
+  uint16_t off;
+};
+
+struct HostPca9685 {
+  bool present = true;
+  uint8_t regs[256] = {};
+};
+
+// Boards on the bus, by 7-bit address. 0x40 and 0x41 are present at boot.
+HostPca9685 &hostBoard(uint8_t address);
+void hostRemoveBoard(uint8_t address);
+
+const std::vector<HostI2cTransaction> &hostI2cLog();
+const std::vector<HostChannelWrite> &hostChannelWrites();
+void hostClearBusLog();
+
+// Address, register and data bytes, as the sketch counts them
+uint64_t hostI2cBytes();
+
+// HTTP
+
+struct HostResponse {
+  int code = 0;
+  std::string contentType;
+  std::string body;
+  std::map<std::string, std::string> headers;
+  uint64_t latencyNs = 0;      // wall time spent in the handler
+  uint64_t allocations = 0;    // heap allocations made while serving
+};
+
+// Serve one request through the sketch's handlers, as the async TCP task
+// would between two loop() iterations. url may carry a query string.
+HostResponse hostHttp(const std::string &method, const std::string &url, const std::string &body = "",
+                      const std::map<std::string, std::string> &headers = {});
+
+// Stream image to a route's upload handler in chunkSize pieces, running
+// the firmware for chunkMs between them. The client drops the connection
+// before the chunk that would pass disconnectAt bytes, if that comes first;
+// the response is then empty (code 0).
+HostResponse hostUpload(const std::string &url, const std::string &image, size_t chunkSize, uint32_t chunkMs = 0,
+                        size_t disconnectAt = SIZE_MAX, const std::map<std::string, std::string> &headers = {});
+
+// Other channels
+
+void hostWebSocketBinary(const std::vector<uint8_t> &frame);
+void hostSetWebSocketClients(int clients);
+const std::vector<std::string> &hostWebSocketBroadcasts();
+
+void hostUdpPacket(const std::vector<uint8_t> &packet, uint32_t ip = 0x7F000001, uint16_t port = 40000);
+
+// Replay an espota session: start, progress to total, then end or error
+void hostOtaSession(unsigned int total, bool fail);
+
+// LittleFS
+
+// Root directory of the simulated partition
+std::string hostFsRoot();
+
+// Cap the partition; writes past it come back short (0 = unlimited)
+void hostFsSetCapacity(size_t bytes);
+
+// LittleFS opens (files and directories), writes and removes, plus NVS
+// writes, so far
+uint64_t hostFlashOps();
+
+// Heap
+
+// Allocations (malloc and operator new) made by the process so far
+uint64_t hostAllocations();
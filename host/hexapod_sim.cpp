@@ -0,0 +1,170 @@
+// Runs the firmware on the host in real time with its REST API on a local
+// port, so the dashboard and client scripts can be pointed at it:
+//
+//   hexapod_sim [--port 8080] [--trace-out session.trace]
+//
+// --trace-out logs each request in the trace format test/replay.cpp reads,
+// timed from the first request, so a session can become a regression test.
+//
+// Requests are served between loop() iterations, every pending one each
+// time, as the async TCP task would, while the motion task ticks on its
+// own thread. One request per connection; the reply closes it.
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <strings.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "hexapod_host.h"
+
+static int openListener(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return -1;
+  int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (bind(fd, (sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+    close(fd);
+    return -1;
+  }
+  fcntl(fd, F_SETFL, O_NONBLOCK);
+  return fd;
+}
+
+// Read one request: headers, then Content-Length bytes of body
+static bool readRequest(int fd, std::string &method, std::string &url, std::string &body,
+                        std::map<std::string, std::string> &headers) {
+  std::string raw;
+  char buf[4096];
+  size_t headerEnd = std::string::npos;
+  size_t contentLength = 0;
+  while (true) {
+    pollfd p = {fd, POLLIN, 0};
+    if (poll(&p, 1, 2000) <= 0) return false;
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n <= 0) return false;
+    raw.append(buf, n);
+
+    if (headerEnd == std::string::npos) {
+      headerEnd = raw.find("\r\n\r\n");
+      if (headerEnd == std::string::npos) continue;
+
+      size_t lineEnd = raw.find("\r\n");
+      std::string requestLine = raw.substr(0, lineEnd);
+      size_t sp1 = requestLine.find(' ');
+      size_t sp2 = requestLine.find(' ', sp1 + 1);
+      if (sp1 == std::string::npos || sp2 == std::string::npos) return false;
+      method = requestLine.substr(0, sp1);
+      url = requestLine.substr(sp1 + 1, sp2 - sp1 - 1);
+
+      size_t pos = lineEnd + 2;
+      while (pos < headerEnd) {
+        size_t end = raw.find("\r\n", pos);
+        std::string line = raw.substr(pos, end - pos);
+        size_t colon = line.find(':');
+        if (colon != std::string::npos) {
+          std::string name = line.substr(0, colon);
+          std::string value = line.substr(colon + 1);
+          value.erase(0, value.find_first_not_of(' '));
+          headers[name] = value;
+          if (strcasecmp(name.c_str(), "Content-Length") == 0) contentLength = strtoul(value.c_str(), nullptr, 10);
+        }
+        pos = end + 2;
+      }
+    }
+    if (raw.size() >= headerEnd + 4 + contentLength) {
+      body = raw.substr(headerEnd + 4, contentLength);
+      return true;
+    }
+  }
+}
+
+static FILE *traceOut = nullptr;
+static uint64_t traceStartUs = 0;
+
+static void traceRequest(const std::string &method, const std::string &url, const std::string &body) {
+  if (!traceOut) return;
+  if (!traceStartUs) traceStartUs = hostNowUs();
+  std::string line = body;
+  for (char &c : line) {
+    if (c == '\r' || c == '\n') c = ' ';
+  }
+  fprintf(traceOut, "%llu %s %s%s%s\n", (unsigned long long)((hostNowUs() - traceStartUs) / 1000), method.c_str(),
+          url.c_str(), line.empty() ? "" : " ", line.c_str());
+  fflush(traceOut);
+}
+
+static void serveClient(int fd) {
+  std::string method, url, body;
+  std::map<std::string, std::string> headers;
+  if (!readRequest(fd, method, url, body, headers)) return;
+  traceRequest(method, url, body);
+
+  HostResponse response = hostHttp(method, url, body, headers);
+  std::string out = "HTTP/1.1 " + std::to_string(response.code) + " \r\n";
+  if (!response.contentType.empty()) out += "Content-Type: " + response.contentType + "\r\n";
+  for (const auto &header : response.headers) out += header.first + ": " + header.second + "\r\n";
+  out += "Content-Length: " + std::to_string(response.body.size()) + "\r\n";
+  out += "Access-Control-Allow-Origin: *\r\nConnection: close\r\n\r\n";
+  out += response.body;
+
+  size_t sent = 0;
+  while (sent < out.size()) {
+    ssize_t n = send(fd, out.data() + sent, out.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) break;
+    sent += n;
+  }
+}
+
+int main(int argc, char **argv) {
+  int port = 8080;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--port") == 0 && i + 1 < argc) {
+      port = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--trace-out") == 0 && i + 1 < argc) {
+      traceOut = fopen(argv[++i], "w");
+      if (!traceOut) {
+        perror(argv[i]);
+        return 1;
+      }
+    } else {
+      fprintf(stderr, "usage: %s [--port N] [--trace-out FILE]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  int listener = openListener(port);
+  if (listener < 0) {
+    perror("listen");
+    return 1;
+  }
+
+  hostSetRealtime(true);
+  hostBoot();
+  printf("hexapod_sim: http://127.0.0.1:%d/\n", port);
+  fflush(stdout);
+
+  while (!hostRestartRequested()) {
+    hostRun(1);
+    // Everything that connected meanwhile, as the async TCP task would
+    int client;
+    while ((client = accept(listener, nullptr, nullptr)) >= 0) {
+      serveClient(client);
+      close(client);
+    }
+  }
+  close(listener);
+  if (traceOut) fclose(traceOut);
+  return 0;
+}
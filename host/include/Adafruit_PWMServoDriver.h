@@ -0,0 +1,45 @@
+// Host stand-in for Adafruit_PWMServoDriver. Issues the same register
+// writes as the real library over the simulated Wire bus, so board
+// bring-up shows up in the bus log exactly as on hardware.
+#pragma once
+
+#include "Arduino.h"
+#include "Wire.h"
+
+#define PCA9685_MODE1 0x00
+#define PCA9685_MODE2 0x01
+#define PCA9685_LED0_ON_L 0x06
+#define PCA9685_ALLLED_ON_L 0xFA
+#define PCA9685_PRESCALE 0xFE
+
+#define MODE1_ALLCAL 0x01
+#define MODE1_SLEEP 0x10
+#define MODE1_AI 0x20
+#define MODE1_EXTCLK 0x40
+#define MODE1_RESTART 0x80
+
+#define PCA9685_I2C_ADDRESS 0x40
+#define FREQUENCY_OSCILLATOR 25000000
+#define PCA9685_PRESCALE_MIN 3
+#define PCA9685_PRESCALE_MAX 255
+
+class Adafruit_PWMServoDriver {
+ public:
+  explicit Adafruit_PWMServoDriver(uint8_t addr = PCA9685_I2C_ADDRESS, TwoWire &i2c = Wire)
+    : addr_(addr), i2c_(i2c) {}
+
+  bool begin(uint8_t prescale = 0);
+  void reset();
+  void setOscillatorFrequency(uint32_t freq) { oscillatorFreq_ = freq; }
+  uint32_t getOscillatorFrequency() const { return oscillatorFreq_; }
+  void setPWMFreq(float freq);
+  uint8_t setPWM(uint8_t num, uint16_t on, uint16_t off);
+
+ private:
+  uint8_t read8(uint8_t reg);
+  void write8(uint8_t reg, uint8_t value);
+
+  uint8_t addr_;
+  TwoWire &i2c_;
+  uint32_t oscillatorFreq_ = FREQUENCY_OSCILLATOR;
+};
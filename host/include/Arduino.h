@@ -0,0 +1,189 @@
+// Host stand-in for the ESP32 Arduino core: String, Print, Serial, a
+// simulated clock and the few FreeRTOS calls the sketch makes. Only what
+// Hexapod_Basic_v1.cpp uses is provided.
+#pragma once
+
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#define PROGMEM
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#if defined(__GLIBC__) && (__GLIBC__ < 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ < 38))
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+#endif
+
+class String {
+ public:
+  String() {}
+  String(const char *s) : s_(s ? s : "") {}
+  String(const std::string &s) : s_(s) {}
+  explicit String(char c) : s_(1, c) {}
+  String(int v) : s_(std::to_string(v)) {}
+  String(unsigned v) : s_(std::to_string(v)) {}
+  String(long v) : s_(std::to_string(v)) {}
+  String(unsigned long v) : s_(std::to_string(v)) {}
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned length() const { return s_.size(); }
+  bool isEmpty() const { return s_.empty(); }
+  long toInt() const { return strtol(s_.c_str(), nullptr, 10); }
+  bool startsWith(const String &p) const { return s_.compare(0, p.s_.size(), p.s_) == 0; }
+  String substring(unsigned from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    return from < s_.size() && from < to ? String(s_.substr(from, to - from)) : String();
+  }
+  int indexOf(char c) const {
+    size_t at = s_.find(c);
+    return at == std::string::npos ? -1 : (int)at;
+  }
+  char operator[](unsigned i) const { return i < s_.size() ? s_[i] : '\0'; }
+
+  bool operator==(const String &o) const { return s_ == o.s_; }
+  bool operator==(const char *o) const { return s_ == (o ? o : ""); }
+  bool operator!=(const String &o) const { return s_ != o.s_; }
+  bool operator!=(const char *o) const { return !(*this == o); }
+  String &operator+=(const String &o) { s_ += o.s_; return *this; }
+  String &operator+=(const char *o) { s_ += o; return *this; }
+  String &operator+=(char c) { s_ += c; return *this; }
+
+  friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+
+  const std::string &str() const { return s_; }
+
+ private:
+  std::string s_;
+};
+
+class IPAddress {
+ public:
+  IPAddress() {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+    : addr_((uint32_t)a << 24 | (uint32_t)b << 16 | (uint32_t)c << 8 | d) {}
+  explicit IPAddress(uint32_t addr) : addr_(addr) {}
+  bool operator==(const IPAddress &o) const { return addr_ == o.addr_; }
+  bool operator!=(const IPAddress &o) const { return addr_ != o.addr_; }
+  uint32_t value() const { return addr_; }
+  String toString() const {
+    char buf[16];
+    snprintf(buf, sizeof(buf), "%u.%u.%u.%u", (unsigned)(addr_ >> 24), (unsigned)(addr_ >> 16 & 0xFF),
+             (unsigned)(addr_ >> 8 & 0xFF), (unsigned)(addr_ & 0xFF));
+    return String(buf);
+  }
+
+ private:
+  uint32_t addr_ = 0;
+};
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buf, size_t len) {
+    for (size_t i = 0; i < len; i++) write(buf[i]);
+    return len;
+  }
+
+  size_t print(const char *s) { return write((const uint8_t *)s, strlen(s)); }
+  size_t print(const String &s) { return print(s.c_str()); }
+  size_t print(const IPAddress &ip) { return print(ip.toString()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  size_t print(int v) { return printf("%d", v); }
+  size_t print(unsigned v) { return printf("%u", v); }
+  size_t print(long v) { return printf("%ld", v); }
+  size_t print(unsigned long v) { return printf("%lu", v); }
+  size_t print(double v) { return printf("%.2f", v); }
+
+  size_t println() { return print("\r\n"); }
+  template <class T> size_t println(const T &v) { return print(v) + println(); }
+
+  size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+    char stackBuf[256];
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(stackBuf, sizeof(stackBuf), fmt, args);
+    va_end(args);
+    if (n < 0) return 0;
+    if ((size_t)n < sizeof(stackBuf)) return write((const uint8_t *)stackBuf, n);
+
+    std::string big(n + 1, '\0');
+    va_start(args, fmt);
+    vsnprintf(&big[0], big.size(), fmt, args);
+    va_end(args);
+    return write((const uint8_t *)big.data(), n);
+  }
+};
+
+// Serial output is dropped unless HEXAPOD_VERBOSE is set in the environment
+class HardwareSerial : public Print {
+ public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buf, size_t len) override;
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+// Simulated clock, see hexapod_host.h
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+struct EspClass {
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+  uint32_t getFreeHeap();
+  void restart();
+};
+
+extern EspClass ESP;
+
+int64_t esp_timer_get_time();
+
+// FreeRTOS on std::thread: tasks are threads, mutexes are real mutexes.
+// On the simulated clock tasks run in lockstep with delay() (see
+// host/src/arduino.cpp).
+typedef void *SemaphoreHandle_t;
+typedef void *TaskHandle_t;
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS pdTRUE
+#define portMAX_DELAY 0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+SemaphoreHandle_t xSemaphoreCreateMutex();
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem);
+TickType_t xTaskGetTickCount();
+void vTaskDelayUntil(TickType_t *lastWake, TickType_t period);
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *name, uint32_t stack,
+                                   void *arg, int priority, TaskHandle_t *handle, int core);
+
+// Sketch entry points
+void setup();
+void loop();
@@ -0,0 +1,46 @@
+// Host stand-in for ArduinoOTA. Callbacks are kept so a test can drive an
+// espota session with hostOtaSession().
+#pragma once
+
+#include "Arduino.h"
+
+#define U_FLASH 0
+#define U_SPIFFS 100
+
+typedef enum {
+  OTA_AUTH_ERROR,
+  OTA_BEGIN_ERROR,
+  OTA_CONNECT_ERROR,
+  OTA_RECEIVE_ERROR,
+  OTA_END_ERROR,
+} ota_error_t;
+
+class ArduinoOTAClass {
+ public:
+  typedef std::function<void()> THandlerFunction;
+  typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+  typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+  ArduinoOTAClass &setPort(uint16_t port) { port_ = port; return *this; }
+  ArduinoOTAClass &setHostname(const char *hostname) { (void)hostname; return *this; }
+  ArduinoOTAClass &setPassword(const char *password) { (void)password; return *this; }
+  ArduinoOTAClass &onStart(THandlerFunction fn) { onStart_ = fn; return *this; }
+  ArduinoOTAClass &onEnd(THandlerFunction fn) { onEnd_ = fn; return *this; }
+  ArduinoOTAClass &onError(THandlerFunction_Error fn) { onError_ = fn; return *this; }
+  ArduinoOTAClass &onProgress(THandlerFunction_Progress fn) { onProgress_ = fn; return *this; }
+  void begin() {}
+  void handle() {}
+  int getCommand() { return U_FLASH; }
+
+  // Host side: replay a session of the given size, failing with error if set
+  void session(unsigned int total, bool fail, ota_error_t error);
+
+ private:
+  uint16_t port_ = 3232;
+  THandlerFunction onStart_;
+  THandlerFunction onEnd_;
+  THandlerFunction_Error onError_;
+  THandlerFunction_Progress onProgress_;
+};
+
+extern ArduinoOTAClass ArduinoOTA;
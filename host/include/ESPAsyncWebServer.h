@@ -0,0 +1,159 @@
+// Host stand-in for ESPAsyncWebServer. Handlers are matched like the real
+// server (exact url or url + "/...", first registered match wins) and run
+// in-process from hostHttp(); host/hexapod_sim.cpp also feeds them from a
+// plain TCP listener.
+#pragma once
+
+#include "Arduino.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+typedef uint8_t WebRequestMethodComposite;
+
+enum WebRequestMethod : uint8_t {
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_DELETE = 0b00000100,
+  HTTP_PUT = 0b00001000,
+  HTTP_PATCH = 0b00010000,
+  HTTP_HEAD = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY = 0b01111111,
+};
+
+class AsyncWebServerRequest;
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, const String &filename, size_t index,
+                           uint8_t *data, size_t len, bool final)> ArUploadHandlerFunction;
+typedef std::function<void(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index,
+                           size_t total)> ArBodyHandlerFunction;
+typedef std::function<void()> ArDisconnectHandler;
+
+class AsyncWebHeader {
+ public:
+  AsyncWebHeader(const String &name, const String &value) : name_(name), value_(value) {}
+  const String &name() const { return name_; }
+  const String &value() const { return value_; }
+
+ private:
+  String name_;
+  String value_;
+};
+
+class AsyncWebParameter {
+ public:
+  AsyncWebParameter(const String &name, const String &value) : name_(name), value_(value) {}
+  const String &name() const { return name_; }
+  const String &value() const { return value_; }
+
+ private:
+  String name_;
+  String value_;
+};
+
+class AsyncWebServerResponse {
+ public:
+  AsyncWebServerResponse(int code, const String &contentType, const std::string &content)
+    : code_(code), contentType_(contentType), content_(content) {}
+  virtual ~AsyncWebServerResponse() {}
+
+  void addHeader(const String &name, const String &value) { headers_.emplace_back(name, value); }
+
+  int code() const { return code_; }
+  const String &contentType() const { return contentType_; }
+  const std::string &content() const { return content_; }
+  const std::vector<AsyncWebHeader> &headers() const { return headers_; }
+
+ protected:
+  int code_;
+  String contentType_;
+  std::string content_;
+  std::vector<AsyncWebHeader> headers_;
+};
+
+class AsyncResponseStream : public AsyncWebServerResponse, public Print {
+ public:
+  explicit AsyncResponseStream(const String &contentType) : AsyncWebServerResponse(200, contentType, "") {}
+  size_t write(uint8_t c) override {
+    content_ += (char)c;
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t len) override {
+    content_.append((const char *)buf, len);
+    return len;
+  }
+  using Print::write;
+};
+
+class AsyncWebServerRequest {
+ public:
+  AsyncWebServerRequest(WebRequestMethodComposite method, const String &url, const std::string &body);
+  ~AsyncWebServerRequest();
+
+  void *_tempObject = nullptr;
+
+  WebRequestMethodComposite method() const { return method_; }
+  const String &url() const { return url_; }
+  size_t contentLength() const { return body_.size(); }
+
+  void addHeader(const String &name, const String &value) { headers_.emplace_back(name, value); }
+  bool hasHeader(const String &name) const;
+  AsyncWebHeader *getHeader(const String &name) const;
+  bool hasParam(const String &name, bool post = false, bool file = false) const;
+  AsyncWebParameter *getParam(const String &name, bool post = false, bool file = false) const;
+
+  void onDisconnect(ArDisconnectHandler fn) { onDisconnect_ = fn; }
+
+  void send(AsyncWebServerResponse *response);
+  void send(int code, const String &contentType = String(), const String &content = String());
+  AsyncWebServerResponse *beginResponse(int code, const String &contentType = String(),
+                                        const String &content = String());
+  AsyncWebServerResponse *beginResponse_P(int code, const String &contentType, const uint8_t *content,
+                                          size_t len);
+  AsyncResponseStream *beginResponseStream(const String &contentType, size_t bufferSize = 1460);
+
+  // Host side
+  const std::string &body() const { return body_; }
+  AsyncWebServerResponse *response() const { return response_.get(); }
+  void disconnect();
+
+ private:
+  WebRequestMethodComposite method_;
+  String url_;
+  std::string body_;
+  mutable std::vector<AsyncWebHeader> headers_;
+  mutable std::vector<AsyncWebParameter> params_;
+  std::unique_ptr<AsyncWebServerResponse> response_;
+  ArDisconnectHandler onDisconnect_;
+};
+
+class AsyncWebServer {
+ public:
+  explicit AsyncWebServer(uint16_t port) : port_(port) {}
+
+  void on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+  void on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+          ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody = nullptr);
+  void begin();
+
+  // Host side: run one request through the matching handler
+  void handle(AsyncWebServerRequest *request);
+  uint16_t port() const { return port_; }
+
+  struct Handler {
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+    ArUploadHandlerFunction onUpload;
+    ArBodyHandlerFunction onBody;
+  };
+  Handler *find(AsyncWebServerRequest *request);
+
+ private:
+
+  uint16_t port_;
+  std::vector<Handler> handlers_;
+};
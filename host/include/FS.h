@@ -0,0 +1,54 @@
+// Host stand-in for the Arduino FS File and FS classes, backed by a
+// directory on the host file system.
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+
+namespace fs {
+
+class FileImpl;
+
+class File {
+ public:
+  File() {}
+  explicit File(std::shared_ptr<FileImpl> impl) : impl_(impl) {}
+
+  explicit operator bool() const;
+  size_t write(uint8_t c) { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t size);
+  int read();
+  size_t read(uint8_t *buf, size_t size);
+  int available();
+  size_t size() const;
+  size_t position() const;
+  bool seek(uint32_t pos);
+  void flush() {}
+  void close();
+  const char *name() const;
+  const char *path() const;
+  bool isDirectory() const;
+  File openNextFile(const char *mode = "r");
+
+ private:
+  std::shared_ptr<FileImpl> impl_;
+};
+
+class FS {
+ public:
+  File open(const char *path, const char *mode = "r", bool create = false);
+  File open(const String &path, const char *mode = "r", bool create = false) {
+    return open(path.c_str(), mode, create);
+  }
+  bool exists(const char *path);
+  bool remove(const char *path);
+  bool rename(const char *from, const char *to);
+  bool mkdir(const char *path);
+  bool rmdir(const char *path);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
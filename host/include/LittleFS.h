@@ -0,0 +1,20 @@
+// Host stand-in for LittleFS. The root is $HEXAPOD_FS_ROOT, or a fresh
+// temporary directory per process.
+#pragma once
+
+#include "FS.h"
+
+namespace fs {
+
+class LittleFSFS : public FS {
+ public:
+  bool begin(bool formatOnFail = false, const char *basePath = "/littlefs", uint8_t maxOpenFiles = 10,
+             const char *partitionLabel = "spiffs");
+  void end() {}
+  size_t totalBytes();
+  size_t usedBytes();
+};
+
+}  // namespace fs
+
+extern fs::LittleFSFS LittleFS;
@@ -0,0 +1,21 @@
+// Host stand-in for the ESP32 Preferences (NVS) library, held in memory for
+// the life of the process.
+#pragma once
+
+#include "Arduino.h"
+
+class Preferences {
+ public:
+  bool begin(const char *name, bool readOnly = false, const char *partitionLabel = nullptr);
+  void end() {}
+  bool remove(const char *key);
+  bool isKey(const char *key);
+  size_t putUShort(const char *key, uint16_t value);
+  uint16_t getUShort(const char *key, uint16_t defaultValue = 0);
+  size_t putBytes(const char *key, const void *value, size_t len);
+  size_t getBytesLength(const char *key);
+  size_t getBytes(const char *key, void *buf, size_t maxLen);
+
+ private:
+  std::string ns_;
+};
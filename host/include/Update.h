@@ -0,0 +1,33 @@
+// Host stand-in for the ESP32 Update class: the image is kept in memory.
+#pragma once
+
+#include "Arduino.h"
+
+#define UPDATE_SIZE_UNKNOWN 0xFFFFFFFF
+#define U_FLASH 0
+
+class UpdateClass {
+ public:
+  bool begin(size_t size = UPDATE_SIZE_UNKNOWN, int command = U_FLASH);
+  size_t write(uint8_t *data, size_t len);
+  bool end(bool evenIfRemaining = false);
+  void abort();
+  void printError(Print &out);
+  bool hasError() const { return error_ != 0; }
+  bool isRunning() const { return running_; }
+  size_t progress() const { return image_.size(); }
+  size_t size() const { return size_; }
+
+  // Host side
+  const std::string &image() const { return image_; }
+  bool finished() const { return finished_; }
+
+ private:
+  std::string image_;
+  size_t size_ = 0;
+  bool running_ = false;
+  bool finished_ = false;
+  uint8_t error_ = 0;
+};
+
+extern UpdateClass Update;
@@ -0,0 +1,36 @@
+// Host stand-in for the links2004 WebSocketsServer. Frames are injected with
+// hostWebSocketBinary() and broadcasts are kept for the tests to inspect.
+#pragma once
+
+#include "Arduino.h"
+
+typedef enum {
+  WStype_ERROR,
+  WStype_DISCONNECTED,
+  WStype_CONNECTED,
+  WStype_TEXT,
+  WStype_BIN,
+} WStype_t;
+
+class WebSocketsServer {
+ public:
+  typedef std::function<void(uint8_t num, WStype_t type, uint8_t *payload, size_t length)> WebSocketServerEvent;
+
+  explicit WebSocketsServer(uint16_t port) : port_(port) {}
+
+  void begin();
+  void loop() {}
+  void onEvent(WebSocketServerEvent cbEvent) { event_ = cbEvent; }
+  bool broadcastTXT(const char *payload, size_t length = 0, bool headerToPayload = false);
+  bool broadcastTXT(const String &payload) { return broadcastTXT(payload.c_str(), payload.length()); }
+  int connectedClients(bool ping = false);
+
+  // Host side
+  void deliver(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+    if (event_) event_(num, type, payload, length);
+  }
+
+ private:
+  uint16_t port_;
+  WebSocketServerEvent event_;
+};
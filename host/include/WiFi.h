@@ -0,0 +1,27 @@
+// Host stand-in for the ESP32 WiFi class: always connected, on loopback.
+#pragma once
+
+#include "Arduino.h"
+
+typedef enum {
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL = 1,
+  WL_SCAN_COMPLETED = 2,
+  WL_CONNECTED = 3,
+  WL_CONNECT_FAILED = 4,
+  WL_CONNECTION_LOST = 5,
+  WL_DISCONNECTED = 6,
+} wl_status_t;
+
+class WiFiClass {
+ public:
+  bool config(IPAddress local, IPAddress gateway, IPAddress subnet, IPAddress dns1 = IPAddress(),
+              IPAddress dns2 = IPAddress()) {
+    return true;
+  }
+  wl_status_t begin(const char *ssid, const char *passphrase = nullptr) { return WL_CONNECTED; }
+  wl_status_t status() { return WL_CONNECTED; }
+  IPAddress localIP() { return IPAddress(127, 0, 0, 1); }
+};
+
+extern WiFiClass WiFi;
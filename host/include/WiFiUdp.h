@@ -0,0 +1,20 @@
+// Host stand-in for WiFiUDP. Datagrams are queued with hostUdpPacket().
+#pragma once
+
+#include "Arduino.h"
+
+class WiFiUDP {
+ public:
+  uint8_t begin(uint16_t port);
+  int parsePacket();
+  int read(uint8_t *buffer, size_t len);
+  int available();
+  IPAddress remoteIP() { return remoteIP_; }
+  uint16_t remotePort() { return remotePort_; }
+
+ private:
+  std::string packet_;
+  size_t pos_ = 0;
+  IPAddress remoteIP_;
+  uint16_t remotePort_ = 0;
+};
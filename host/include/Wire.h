@@ -0,0 +1,28 @@
+// Host stand-in for the ESP32 Wire library. Transactions go to the
+// simulated I2C bus in host/src/wire.cpp, which models the PCA9685
+// register file and records every transaction for the tests.
+#pragma once
+
+#include "Arduino.h"
+
+#include <vector>
+
+class TwoWire {
+ public:
+  bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0);
+  void beginTransmission(uint8_t address);
+  size_t write(uint8_t data);
+  size_t write(const uint8_t *data, size_t len);
+  uint8_t endTransmission(bool sendStop = true);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity, bool sendStop = true);
+  int available();
+  int read();
+
+ private:
+  uint8_t txAddress_ = 0;
+  std::vector<uint8_t> tx_;
+  std::vector<uint8_t> rx_;
+  size_t rxPos_ = 0;
+};
+
+extern TwoWire Wire;
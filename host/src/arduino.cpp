@@ -0,0 +1,319 @@
+// Arduino core stand-in: simulated clock, Serial, ESP, the FreeRTOS calls
+// the sketch makes, and the allocation counter behind hostAllocations().
+#include <Arduino.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "../hexapod_host.h"
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// Clock. Simulated time only moves when delay() or hostAdvanceUs() moves
+// it; in realtime mode it follows the wall clock from where it was.
+
+static std::atomic<uint64_t> simUs{0};
+static std::atomic<bool> realtime{false};
+static std::chrono::steady_clock::time_point realStart;
+static std::atomic<uint64_t> realBaseUs{0};
+static bool restartRequested = false;
+
+static uint64_t realNowUs() {
+  auto elapsed = std::chrono::steady_clock::now() - realStart;
+  return realBaseUs + std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+}
+
+uint64_t hostNowUs() { return realtime ? realNowUs() : simUs.load(); }
+
+static void advanceUs(uint64_t us);
+
+void hostAdvanceUs(uint64_t us) {
+  if (realtime) {
+    realBaseUs += us;
+  } else {
+    advanceUs(us);
+  }
+}
+
+void hostSetRealtime(bool enable) {
+  if (enable == realtime) return;
+  if (enable) {
+    realBaseUs = simUs.load();
+    realStart = std::chrono::steady_clock::now();
+  } else {
+    simUs = realNowUs();
+  }
+  realtime = enable;
+}
+
+bool hostRestartRequested() { return restartRequested; }
+
+uint32_t millis() { return (uint32_t)(hostNowUs() / 1000); }
+
+uint32_t micros() { return (uint32_t)hostNowUs(); }
+
+int64_t esp_timer_get_time() { return (int64_t)hostNowUs(); }
+
+void delayMicroseconds(uint32_t us) {
+  if (realtime) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+  } else {
+    advanceUs(us);
+  }
+}
+
+void delay(uint32_t ms) { delayMicroseconds(ms * 1000); }
+
+void yield() {}
+
+// Serial
+
+static bool serialVerbose() {
+  static int verbose = -1;
+  if (verbose < 0) verbose = getenv("HEXAPOD_VERBOSE") != nullptr;
+  return verbose;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (serialVerbose()) fputc(c, stderr);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len) {
+  if (serialVerbose()) fwrite(buf, 1, len, stderr);
+  return len;
+}
+
+// ESP
+
+uint32_t EspClass::getCycleCount() { return (uint32_t)(hostNowUs() * getCpuFreqMHz()); }
+
+uint32_t EspClass::getFreeHeap() { return 200 * 1024; }
+
+void EspClass::restart() { restartRequested = true; }
+
+// FreeRTOS. Mutexes are real mutexes; taking one the same thread already
+// holds can never succeed, so that is reported instead of hanging.
+
+struct HostMutex {
+  std::mutex mutex;
+  std::atomic<std::thread::id> owner{};
+};
+
+SemaphoreHandle_t xSemaphoreCreateMutex() { return new HostMutex(); }
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t wait) {
+  HostMutex *mutex = (HostMutex *)sem;
+  if (mutex->owner.load() == std::this_thread::get_id()) {
+    if (wait == portMAX_DELAY) {
+      fprintf(stderr, "host: deadlock, mutex taken twice with portMAX_DELAY\n");
+      abort();
+    }
+    return pdFALSE;
+  }
+  bool taken;
+  if (wait == portMAX_DELAY) {
+    mutex->mutex.lock();
+    taken = true;
+  } else if (wait == 0) {
+    taken = mutex->mutex.try_lock();
+  } else {
+    // Poll rather than pthread_mutex_timedlock, which TSan does not follow
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait);
+    while (!(taken = mutex->mutex.try_lock()) && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+  if (!taken) return pdFALSE;
+  mutex->owner = std::this_thread::get_id();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t sem) {
+  HostMutex *mutex = (HostMutex *)sem;
+  if (mutex->owner.load() != std::this_thread::get_id()) return pdFALSE;
+  mutex->owner = std::thread::id();
+  mutex->mutex.unlock();
+  return pdTRUE;
+}
+
+TickType_t xTaskGetTickCount() { return millis(); }
+
+// Tasks run on their own threads. On the simulated clock they run in
+// lockstep with loop(), as a higher-priority task would: when delay()
+// moves the clock past a task's wake time, the clock stops there, the task
+// runs until its next vTaskDelayUntil(), and only then does delay() go on.
+// That keeps every run deterministic. In realtime mode tasks just sleep
+// and run concurrently with loop().
+
+struct HostTask {
+  void (*entry)(void *);
+  void *arg;
+  uint64_t wakeUs = 0;
+  bool parked = false;     // waiting in vTaskDelayUntil()
+  bool released = false;   // woken by the clock, not yet parked again
+};
+
+// Leaked so tasks still parked at exit never wait on a destroyed object
+static std::mutex &taskMutex = *new std::mutex;
+static std::condition_variable &taskWake = *new std::condition_variable;
+static std::vector<HostTask *> tasks;
+static bool tasksStopping = false;
+static thread_local HostTask *currentTask = nullptr;
+
+// Called by the clock owner: run every task that falls due before the
+// clock reaches target, in wake order
+static void advanceUs(uint64_t us) {
+  uint64_t target = simUs + us;
+  if (!currentTask) {
+    std::unique_lock<std::mutex> lock(taskMutex);
+    for (;;) {
+      HostTask *next = nullptr;
+      for (HostTask *task : tasks) {
+        if (task->parked && !task->released && task->wakeUs <= target &&
+            (!next || task->wakeUs < next->wakeUs)) {
+          next = task;
+        }
+      }
+      if (!next || tasksStopping) break;
+      if (next->wakeUs > simUs) simUs = next->wakeUs;
+      next->released = true;
+      taskWake.notify_all();
+      taskWake.wait(lock, [next] { return next->parked && !next->released; });
+    }
+  }
+  if (simUs < target) simUs = target;
+}
+
+static void taskPark(HostTask *task, uint64_t wakeUs) {
+  std::unique_lock<std::mutex> lock(taskMutex);
+  task->wakeUs = wakeUs;
+  task->released = false;
+  task->parked = true;
+  taskWake.notify_all();
+  for (;;) {
+    if (tasksStopping) {
+      taskWake.wait(lock);
+    } else if (task->released) {
+      break;
+    } else if (realtime) {
+      uint64_t now = hostNowUs();
+      if (now >= wakeUs) break;
+      lock.unlock();
+      std::this_thread::sleep_for(std::chrono::microseconds(wakeUs - now));
+      lock.lock();
+    } else {
+      taskWake.wait(lock);
+    }
+  }
+  task->parked = false;
+}
+
+// At exit, let each task finish its current run and keep it parked, so
+// none is still touching sketch state while globals are destroyed
+static void tasksStop() {
+  std::unique_lock<std::mutex> lock(taskMutex);
+  tasksStopping = true;
+  taskWake.notify_all();
+  taskWake.wait(lock, [] {
+    for (HostTask *task : tasks) {
+      if (!task->parked) return false;
+    }
+    return true;
+  });
+}
+
+void vTaskDelayUntil(TickType_t *lastWake, TickType_t period) {
+  *lastWake += period;
+  int32_t wait = (int32_t)(*lastWake - xTaskGetTickCount());
+  if (!currentTask) {
+    if (wait > 0) delay(wait);
+    return;
+  }
+  if (wait <= 0) return;   // overran the period: run again straight away
+  taskPark(currentTask, (hostNowUs() / 1000 + wait) * 1000);
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*entry)(void *), const char *name, uint32_t stack, void *arg,
+                                   int priority, TaskHandle_t *handle, int core) {
+  HostTask *task = new HostTask{entry, arg};
+  {
+    std::lock_guard<std::mutex> lock(taskMutex);
+    if (tasks.empty()) atexit(tasksStop);
+    tasks.push_back(task);
+  }
+  std::thread([task] {
+    currentTask = task;
+    task->entry(task->arg);
+  }).detach();
+
+  // Let it reach its first vTaskDelayUntil() before the caller goes on
+  {
+    std::unique_lock<std::mutex> lock(taskMutex);
+    taskWake.wait(lock, [task] { return task->parked; });
+  }
+  if (handle) *handle = task;
+  return pdPASS;
+}
+
+// Boot and run
+
+void hostBoot() { setup(); }
+
+void hostRun(uint32_t ms) {
+  uint64_t until = hostNowUs() + (uint64_t)ms * 1000;
+  while (hostNowUs() < until) loop();
+}
+
+// Allocation counter. With HOST_WRAP_MALLOC the link wraps malloc, calloc
+// and realloc (and operator new lands there too); otherwise only C++
+// allocations are seen.
+
+static std::atomic<uint64_t> allocations{0};
+
+uint64_t hostAllocations() { return allocations.load(std::memory_order_relaxed); }
+
+#ifdef HOST_WRAP_MALLOC
+extern "C" {
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __real_realloc(ptr, size);
+}
+}
+#endif
+
+static void *countedNew(size_t size) {
+#ifndef HOST_WRAP_MALLOC
+  allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+  void *p = malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void *operator new(size_t size) { return countedNew(size); }
+void *operator new[](size_t size) { return countedNew(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
@@ -0,0 +1,225 @@
+// ESPAsyncWebServer stand-in and hostHttp(). A request runs the way the
+// real server runs it: body (or upload) callback first, then the request
+// handler, then the disconnect callback; deleting it frees _tempObject.
+#include <ESPAsyncWebServer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <strings.h>
+
+#include "../hexapod_host.h"
+
+static AsyncWebServer *activeServer = nullptr;
+
+static std::string urlDecode(const std::string &in) {
+  std::string out;
+  for (size_t i = 0; i < in.size(); i++) {
+    if (in[i] == '+') {
+      out += ' ';
+    } else if (in[i] == '%' && i + 2 < in.size()) {
+      out += (char)strtol(in.substr(i + 1, 2).c_str(), nullptr, 16);
+      i += 2;
+    } else {
+      out += in[i];
+    }
+  }
+  return out;
+}
+
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethodComposite method, const String &url,
+                                             const std::string &body)
+  : method_(method), body_(body) {
+  const std::string &full = url.str();
+  size_t query = full.find('?');
+  url_ = String(full.substr(0, query));
+  if (query == std::string::npos) return;
+
+  std::string rest = full.substr(query + 1);
+  while (!rest.empty()) {
+    size_t amp = rest.find('&');
+    std::string pair = rest.substr(0, amp);
+    size_t eq = pair.find('=');
+    params_.emplace_back(String(urlDecode(pair.substr(0, eq))),
+                         String(eq == std::string::npos ? "" : urlDecode(pair.substr(eq + 1))));
+    rest = amp == std::string::npos ? "" : rest.substr(amp + 1);
+  }
+}
+
+AsyncWebServerRequest::~AsyncWebServerRequest() { free(_tempObject); }
+
+bool AsyncWebServerRequest::hasHeader(const String &name) const { return getHeader(name) != nullptr; }
+
+AsyncWebHeader *AsyncWebServerRequest::getHeader(const String &name) const {
+  for (AsyncWebHeader &header : headers_) {
+    if (strcasecmp(header.name().c_str(), name.c_str()) == 0) return &header;
+  }
+  return nullptr;
+}
+
+bool AsyncWebServerRequest::hasParam(const String &name, bool post, bool file) const {
+  return getParam(name, post, file) != nullptr;
+}
+
+AsyncWebParameter *AsyncWebServerRequest::getParam(const String &name, bool post, bool file) const {
+  if (post || file) return nullptr;   // only query parameters are parsed
+  for (AsyncWebParameter &param : params_) {
+    if (param.name() == name) return &param;
+  }
+  return nullptr;
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse *response) {
+  if (response_) {
+    fprintf(stderr, "host: %s answered twice\n", url_.c_str());
+    delete response;
+    return;
+  }
+  response_.reset(response);
+}
+
+void AsyncWebServerRequest::send(int code, const String &contentType, const String &content) {
+  send(beginResponse(code, contentType, content));
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse(int code, const String &contentType,
+                                                             const String &content) {
+  return new AsyncWebServerResponse(code, contentType, content.str());
+}
+
+AsyncWebServerResponse *AsyncWebServerRequest::beginResponse_P(int code, const String &contentType,
+                                                               const uint8_t *content, size_t len) {
+  return new AsyncWebServerResponse(code, contentType, std::string((const char *)content, len));
+}
+
+AsyncResponseStream *AsyncWebServerRequest::beginResponseStream(const String &contentType, size_t bufferSize) {
+  return new AsyncResponseStream(contentType);
+}
+
+void AsyncWebServerRequest::disconnect() {
+  if (onDisconnect_) onDisconnect_();
+}
+
+void AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) {
+  handlers_.push_back({String(uri), method, onRequest, nullptr, nullptr});
+}
+
+void AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest,
+                        ArUploadHandlerFunction onUpload, ArBodyHandlerFunction onBody) {
+  handlers_.push_back({String(uri), method, onRequest, onUpload, onBody});
+}
+
+void AsyncWebServer::begin() { activeServer = this; }
+
+AsyncWebServer::Handler *AsyncWebServer::find(AsyncWebServerRequest *request) {
+  const String &url = request->url();
+  for (Handler &handler : handlers_) {
+    if (!(handler.method & request->method())) continue;
+    // Exact match or a sub-path, without building uri + "/" per handler so
+    // the allocation count does not depend on route order
+    unsigned n = handler.uri.length();
+    bool subPath = url.length() > n && url.startsWith(handler.uri) && url.c_str()[n] == '/';
+    if (handler.uri == url || subPath) return &handler;
+  }
+  return nullptr;
+}
+
+void AsyncWebServer::handle(AsyncWebServerRequest *request) {
+  Handler *handler = find(request);
+  if (!handler) {
+    request->send(404, "text/plain", "Not found");
+    return;
+  }
+
+  uint8_t *data = (uint8_t *)request->body().data();
+  size_t len = request->body().size();
+  if (len && handler->onUpload) {
+    handler->onUpload(request, String("firmware.bin"), 0, data, len, true);
+  } else if (len && handler->onBody) {
+    handler->onBody(request, data, len, 0, len);
+  }
+  if (handler->onRequest) handler->onRequest(request);
+}
+
+static WebRequestMethodComposite methodFromName(const std::string &name) {
+  if (name == "GET") return HTTP_GET;
+  if (name == "POST") return HTTP_POST;
+  if (name == "PUT") return HTTP_PUT;
+  if (name == "DELETE") return HTTP_DELETE;
+  if (name == "PATCH") return HTTP_PATCH;
+  if (name == "HEAD") return HTTP_HEAD;
+  if (name == "OPTIONS") return HTTP_OPTIONS;
+  return 0;
+}
+
+HostResponse hostHttp(const std::string &method, const std::string &url, const std::string &body,
+                      const std::map<std::string, std::string> &headers) {
+  HostResponse result;
+  if (!activeServer) {
+    result.code = 503;
+    result.body = "server not started";
+    return result;
+  }
+
+  uint64_t allocsBefore = hostAllocations();
+  auto started = std::chrono::steady_clock::now();
+
+  AsyncWebServerRequest *request = new AsyncWebServerRequest(methodFromName(method), String(url), body);
+  for (const auto &header : headers) request->addHeader(String(header.first), String(header.second));
+  activeServer->handle(request);
+  request->disconnect();
+
+  // Covers the request and the response too, as the real server allocates
+  // both per request
+  result.allocations = hostAllocations() - allocsBefore;
+  auto finished = std::chrono::steady_clock::now();
+  result.latencyNs = std::chrono::duration_cast<std::chrono::nanoseconds>(finished - started).count();
+
+  if (AsyncWebServerResponse *response = request->response()) {
+    result.code = response->code();
+    result.contentType = response->contentType().str();
+    result.body = response->content();
+    for (const AsyncWebHeader &header : response->headers()) {
+      result.headers[header.name().str()] = header.value().str();
+    }
+  }
+  delete request;
+  return result;
+}
+
+HostResponse hostUpload(const std::string &url, const std::string &image, size_t chunkSize, uint32_t chunkMs,
+                        size_t disconnectAt, const std::map<std::string, std::string> &headers) {
+  HostResponse result;
+  AsyncWebServerRequest *request = new AsyncWebServerRequest(HTTP_POST, String(url), "");
+  for (const auto &header : headers) request->addHeader(String(header.first), String(header.second));
+  AsyncWebServer::Handler *handler = activeServer ? activeServer->find(request) : nullptr;
+  if (!handler || !handler->onUpload) {
+    delete request;
+    result.code = 404;
+    return result;
+  }
+
+  // One upload callback per chunk, with loop() running in between as it
+  // does while the TCP task waits for the next segment
+  size_t index = 0;
+  do {
+    size_t len = std::min(chunkSize, image.size() - index);
+    if (index + len > disconnectAt) break;
+    bool final = index + len == image.size();
+    handler->onUpload(request, String("firmware.bin"), index, (uint8_t *)image.data() + index, len, final);
+    index += len;
+    if (final) {
+      if (handler->onRequest) handler->onRequest(request);
+      break;
+    }
+    hostRun(chunkMs);
+  } while (index < image.size());
+  request->disconnect();
+
+  if (AsyncWebServerResponse *response = request->response()) {
+    result.code = response->code();
+    result.contentType = response->contentType().str();
+    result.body = response->content();
+  }
+  delete request;
+  return result;
+}
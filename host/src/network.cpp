@@ -0,0 +1,130 @@
+// WiFi, UDP, WebSocket, ArduinoOTA and Update stand-ins. Traffic is
+// injected by the tests through hexapod_host.h instead of a radio.
+#include <ArduinoOTA.h>
+#include <Update.h>
+#include <WebSocketsServer.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+
+#include <deque>
+
+#include "../hexapod_host.h"
+
+WiFiClass WiFi;
+ArduinoOTAClass ArduinoOTA;
+UpdateClass Update;
+
+// UDP
+
+struct HostDatagram {
+  std::string data;
+  uint32_t ip;
+  uint16_t port;
+};
+
+static std::deque<HostDatagram> udpQueue;
+
+void hostUdpPacket(const std::vector<uint8_t> &packet, uint32_t ip, uint16_t port) {
+  udpQueue.push_back({std::string(packet.begin(), packet.end()), ip, port});
+}
+
+uint8_t WiFiUDP::begin(uint16_t port) { return 1; }
+
+int WiFiUDP::parsePacket() {
+  if (udpQueue.empty()) return 0;
+  packet_ = udpQueue.front().data;
+  remoteIP_ = IPAddress(udpQueue.front().ip);
+  remotePort_ = udpQueue.front().port;
+  pos_ = 0;
+  udpQueue.pop_front();
+  return (int)packet_.size();
+}
+
+int WiFiUDP::available() { return (int)(packet_.size() - pos_); }
+
+int WiFiUDP::read(uint8_t *buffer, size_t len) {
+  size_t n = packet_.size() - pos_ < len ? packet_.size() - pos_ : len;
+  memcpy(buffer, packet_.data() + pos_, n);
+  pos_ += n;
+  return (int)n;
+}
+
+// WebSocket
+
+static WebSocketsServer *activeWebSocket = nullptr;
+static int webSocketClients = 0;
+static std::vector<std::string> webSocketBroadcasts;
+
+void WebSocketsServer::begin() { activeWebSocket = this; }
+
+bool WebSocketsServer::broadcastTXT(const char *payload, size_t length, bool headerToPayload) {
+  if (length == 0) length = strlen(payload);
+  webSocketBroadcasts.emplace_back(payload, length);
+  return webSocketClients > 0;
+}
+
+int WebSocketsServer::connectedClients(bool ping) { return webSocketClients; }
+
+// The library hands the callback its own receive buffer, so the copy goes
+// into one that is reused and a frame costs no allocation of its own
+void hostWebSocketBinary(const std::vector<uint8_t> &frame) {
+  if (!activeWebSocket) return;
+  static std::vector<uint8_t> payload;
+  payload.assign(frame.begin(), frame.end());
+  activeWebSocket->deliver(0, WStype_BIN, payload.data(), payload.size());
+}
+
+void hostSetWebSocketClients(int clients) { webSocketClients = clients; }
+
+const std::vector<std::string> &hostWebSocketBroadcasts() { return webSocketBroadcasts; }
+
+// ArduinoOTA
+
+void ArduinoOTAClass::session(unsigned int total, bool fail, ota_error_t error) {
+  if (onStart_) onStart_();
+  for (unsigned int done = 0; done <= total; done += total / 4 ? total / 4 : 1) {
+    if (onProgress_) onProgress_(done, total);
+    if (fail && done >= total / 2) {
+      if (onError_) onError_(error);
+      return;
+    }
+  }
+  if (onEnd_) onEnd_();
+}
+
+void hostOtaSession(unsigned int total, bool fail) { ArduinoOTA.session(total, fail, OTA_RECEIVE_ERROR); }
+
+// Update
+
+bool UpdateClass::begin(size_t size, int command) {
+  image_.clear();
+  size_ = size;
+  running_ = true;
+  finished_ = false;
+  error_ = 0;
+  return true;
+}
+
+size_t UpdateClass::write(uint8_t *data, size_t len) {
+  if (!running_) return 0;
+  image_.append((const char *)data, len);
+  return len;
+}
+
+bool UpdateClass::end(bool evenIfRemaining) {
+  if (!running_ || image_.empty()) {
+    error_ = 1;
+    return false;
+  }
+  if (size_ == UPDATE_SIZE_UNKNOWN || evenIfRemaining) size_ = image_.size();
+  running_ = false;
+  finished_ = image_.size() == size_;
+  return finished_;
+}
+
+void UpdateClass::abort() {
+  running_ = false;
+  error_ = 1;
+}
+
+void UpdateClass::printError(Print &out) { out.printf("Update error %u\n", error_); }
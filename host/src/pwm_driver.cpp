@@ -0,0 +1,67 @@
+// Adafruit_PWMServoDriver stand-in: the register sequence of the real
+// library (reset, sleep, prescale, wake with auto-increment).
+#include <Adafruit_PWMServoDriver.h>
+
+bool Adafruit_PWMServoDriver::begin(uint8_t prescale) {
+  reset();
+  setOscillatorFrequency(FREQUENCY_OSCILLATOR);
+  if (prescale) {
+    uint8_t oldmode = read8(PCA9685_MODE1);
+    write8(PCA9685_MODE1, (oldmode & ~MODE1_RESTART) | MODE1_SLEEP);
+    write8(PCA9685_PRESCALE, prescale);
+    write8(PCA9685_MODE1, oldmode);
+    delay(5);
+    write8(PCA9685_MODE1, oldmode | MODE1_RESTART | MODE1_AI);
+  } else {
+    setPWMFreq(1000);
+  }
+  return true;
+}
+
+void Adafruit_PWMServoDriver::reset() {
+  write8(PCA9685_MODE1, MODE1_RESTART);
+  delay(10);
+}
+
+void Adafruit_PWMServoDriver::setPWMFreq(float freq) {
+  if (freq < 1) freq = 1;
+  if (freq > 3500) freq = 3500;
+
+  float prescaleval = ((oscillatorFreq_ / (freq * 4096.0)) + 0.5) - 1;
+  if (prescaleval < PCA9685_PRESCALE_MIN) prescaleval = PCA9685_PRESCALE_MIN;
+  if (prescaleval > PCA9685_PRESCALE_MAX) prescaleval = PCA9685_PRESCALE_MAX;
+  uint8_t prescale = (uint8_t)prescaleval;
+
+  uint8_t oldmode = read8(PCA9685_MODE1);
+  uint8_t newmode = (oldmode & ~MODE1_RESTART) | MODE1_SLEEP;
+  write8(PCA9685_MODE1, newmode);
+  write8(PCA9685_PRESCALE, prescale);
+  write8(PCA9685_MODE1, oldmode);
+  delay(5);
+  write8(PCA9685_MODE1, oldmode | MODE1_RESTART | MODE1_AI);
+}
+
+uint8_t Adafruit_PWMServoDriver::setPWM(uint8_t num, uint16_t on, uint16_t off) {
+  i2c_.beginTransmission(addr_);
+  i2c_.write(PCA9685_LED0_ON_L + 4 * num);
+  i2c_.write(on);
+  i2c_.write(on >> 8);
+  i2c_.write(off);
+  i2c_.write(off >> 8);
+  return i2c_.endTransmission();
+}
+
+uint8_t Adafruit_PWMServoDriver::read8(uint8_t reg) {
+  i2c_.beginTransmission(addr_);
+  i2c_.write(reg);
+  i2c_.endTransmission();
+  i2c_.requestFrom(addr_, (uint8_t)1);
+  return i2c_.read();
+}
+
+void Adafruit_PWMServoDriver::write8(uint8_t reg, uint8_t value) {
+  i2c_.beginTransmission(addr_);
+  i2c_.write(reg);
+  i2c_.write(value);
+  i2c_.endTransmission();
+}
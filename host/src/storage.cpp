@@ -0,0 +1,249 @@
+// LittleFS over a host directory and Preferences in memory.
+#include <LittleFS.h>
+#include <Preferences.h>
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <unistd.h>
+
+#include "../hexapod_host.h"
+
+namespace stdfs = std::filesystem;
+
+fs::LittleFSFS LittleFS;
+
+// LittleFS
+
+static size_t fsCapacity = 0;
+static size_t fsWritten = 0;
+static uint64_t flashOps = 0;
+
+uint64_t hostFlashOps() { return flashOps; }
+
+// Never destroyed, so the atexit cleanup below can still read it after
+// function-local statics are gone
+static const std::string *fsRoot = nullptr;
+
+std::string hostFsRoot() {
+  if (!fsRoot) {
+    if (const char *env = getenv("HEXAPOD_FS_ROOT")) {
+      stdfs::create_directories(env);
+      fsRoot = new std::string(env);
+    } else {
+      std::string tmpl = (stdfs::temp_directory_path() / "hexapod-fs-XXXXXX").string();
+      if (!mkdtemp(&tmpl[0])) {
+        perror("mkdtemp");
+        abort();
+      }
+      fsRoot = new std::string(tmpl);
+      atexit([] { std::error_code ec; stdfs::remove_all(*fsRoot, ec); });
+    }
+  }
+  return *fsRoot;
+}
+
+void hostFsSetCapacity(size_t bytes) {
+  fsCapacity = bytes;
+  fsWritten = 0;
+}
+
+static stdfs::path hostPath(const char *path) {
+  return stdfs::path(hostFsRoot()) / stdfs::path(path).relative_path();
+}
+
+namespace fs {
+
+class FileImpl {
+ public:
+  std::string path;          // path on the partition, from "/"
+  std::string base;          // last path component
+  bool directory = false;
+  bool writing = false;
+  std::fstream stream;
+  stdfs::directory_iterator entries;
+};
+
+File::operator bool() const { return impl_ != nullptr; }
+
+size_t File::write(const uint8_t *buf, size_t size) {
+  if (!impl_ || !impl_->writing) return 0;
+  flashOps++;
+  if (fsCapacity) {
+    size_t room = fsWritten < fsCapacity ? fsCapacity - fsWritten : 0;
+    if (size > room) size = room;
+  }
+  impl_->stream.write((const char *)buf, size);
+  fsWritten += size;
+  return size;
+}
+
+int File::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+size_t File::read(uint8_t *buf, size_t size) {
+  if (!impl_ || impl_->directory || impl_->writing) return 0;
+  impl_->stream.read((char *)buf, size);
+  return (size_t)impl_->stream.gcount();
+}
+
+int File::available() { return (int)(size() - position()); }
+
+size_t File::size() const {
+  if (!impl_ || impl_->directory) return 0;
+  impl_->stream.flush();
+  std::error_code ec;
+  uintmax_t n = stdfs::file_size(hostPath(impl_->path.c_str()), ec);
+  return ec ? 0 : (size_t)n;
+}
+
+size_t File::position() const {
+  if (!impl_ || impl_->directory) return 0;
+  return impl_->writing ? (size_t)impl_->stream.tellp() : (size_t)impl_->stream.tellg();
+}
+
+bool File::seek(uint32_t pos) {
+  if (!impl_ || impl_->directory) return false;
+  impl_->stream.clear();
+  if (impl_->writing) {
+    impl_->stream.seekp(pos);
+  } else {
+    impl_->stream.seekg(pos);
+  }
+  return (bool)impl_->stream;
+}
+
+void File::close() {
+  if (impl_ && impl_->stream.is_open()) impl_->stream.close();
+  impl_.reset();
+}
+
+const char *File::name() const { return impl_ ? impl_->base.c_str() : ""; }
+
+const char *File::path() const { return impl_ ? impl_->path.c_str() : ""; }
+
+bool File::isDirectory() const { return impl_ && impl_->directory; }
+
+File File::openNextFile(const char *mode) {
+  if (!impl_ || !impl_->directory) return File();
+  stdfs::directory_iterator end;
+  if (impl_->entries == end) return File();
+  std::string child = impl_->path + (impl_->path == "/" ? "" : "/") +
+                      impl_->entries->path().filename().string();
+  ++impl_->entries;
+  return ::LittleFS.open(child.c_str(), mode);
+}
+
+File FS::open(const char *path, const char *mode, bool create) {
+  flashOps++;
+  stdfs::path host = hostPath(path);
+  auto impl = std::make_shared<FileImpl>();
+  impl->path = path;
+  impl->base = stdfs::path(path).filename().string();
+
+  std::error_code ec;
+  if (stdfs::is_directory(host, ec)) {
+    impl->directory = true;
+    impl->entries = stdfs::directory_iterator(host, ec);
+    return File(impl);
+  }
+
+  std::ios::openmode flags = std::ios::binary;
+  if (mode[0] == 'w') {
+    flags |= std::ios::out | std::ios::trunc;
+    impl->writing = true;
+  } else if (mode[0] == 'a') {
+    flags |= std::ios::out | std::ios::app;
+    impl->writing = true;
+  } else {
+    if (!stdfs::exists(host, ec)) return File();
+    flags |= std::ios::in;
+  }
+  impl->stream.open(host, flags);
+  if (!impl->stream.is_open()) return File();
+  return File(impl);
+}
+
+bool FS::exists(const char *path) {
+  std::error_code ec;
+  return stdfs::exists(hostPath(path), ec);
+}
+
+bool FS::remove(const char *path) {
+  flashOps++;
+  std::error_code ec;
+  return stdfs::is_regular_file(hostPath(path), ec) && stdfs::remove(hostPath(path), ec);
+}
+
+bool FS::rename(const char *from, const char *to) {
+  flashOps++;
+  std::error_code ec;
+  stdfs::rename(hostPath(from), hostPath(to), ec);
+  return !ec;
+}
+
+bool FS::mkdir(const char *path) {
+  flashOps++;
+  std::error_code ec;
+  stdfs::create_directories(hostPath(path), ec);
+  return !ec;
+}
+
+bool FS::rmdir(const char *path) {
+  flashOps++;
+  std::error_code ec;
+  return stdfs::remove(hostPath(path), ec);
+}
+
+bool LittleFSFS::begin(bool formatOnFail, const char *basePath, uint8_t maxOpenFiles, const char *partitionLabel) {
+  return !hostFsRoot().empty();
+}
+
+size_t LittleFSFS::totalBytes() { return fsCapacity ? fsCapacity : 1408 * 1024; }
+
+size_t LittleFSFS::usedBytes() { return fsWritten; }
+
+}  // namespace fs
+
+// Preferences
+
+static std::map<std::string, std::string> nvs;
+
+bool Preferences::begin(const char *name, bool readOnly, const char *partitionLabel) {
+  ns_ = name;
+  return true;
+}
+
+bool Preferences::remove(const char *key) {
+  flashOps++;
+  return nvs.erase(ns_ + "/" + key) > 0;
+}
+
+bool Preferences::isKey(const char *key) { return nvs.count(ns_ + "/" + key) > 0; }
+
+size_t Preferences::putUShort(const char *key, uint16_t value) { return putBytes(key, &value, sizeof(value)); }
+
+uint16_t Preferences::getUShort(const char *key, uint16_t defaultValue) {
+  uint16_t value;
+  return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue;
+}
+
+size_t Preferences::putBytes(const char *key, const void *value, size_t len) {
+  flashOps++;
+  nvs[ns_ + "/" + key] = std::string((const char *)value, len);
+  return len;
+}
+
+size_t Preferences::getBytesLength(const char *key) {
+  auto found = nvs.find(ns_ + "/" + key);
+  return found == nvs.end() ? 0 : found->second.size();
+}
+
+size_t Preferences::getBytes(const char *key, void *buf, size_t maxLen) {
+  auto found = nvs.find(ns_ + "/" + key);
+  if (found == nvs.end() || found->second.size() > maxLen) return 0;
+  memcpy(buf, found->second.data(), found->second.size());
+  return found->second.size();
+}
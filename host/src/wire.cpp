@@ -0,0 +1,163 @@
+// Simulated I2C bus with PCA9685 boards on it. Each board keeps a register
+// file with auto-increment, the all-call address and the ALL_LED registers,
+// so a burst, a register read-back or an all-call write lands the way it
+// would on the chip. Every transaction and every channel update is logged.
+#include <Wire.h>
+
+#include <map>
+
+#include "../hexapod_host.h"
+
+TwoWire Wire;
+
+#define REG_MODE1 0x00
+#define REG_ALLCALLADR 0x05
+#define REG_LED0 0x06
+#define REG_ALLLED 0xFA
+#define REG_PRESCALE 0xFE
+#define BIT_ALLCALL 0x01
+#define BIT_AI 0x20
+#define BIT_RESTART 0x80
+
+struct BoardState {
+  HostPca9685 chip;
+  uint8_t pointer = 0;
+};
+
+static void powerOn(HostPca9685 &chip) {
+  memset(chip.regs, 0, sizeof(chip.regs));
+  chip.regs[REG_MODE1] = 0x11;            // SLEEP | ALLCALL
+  chip.regs[0x01] = 0x04;                 // MODE2: OUTDRV
+  chip.regs[0x02] = 0xE2;                 // SUBADR1..3
+  chip.regs[0x03] = 0xE4;
+  chip.regs[0x04] = 0xE8;
+  chip.regs[REG_ALLCALLADR] = 0xE0;       // 0x70 << 1
+  for (int ch = 0; ch < 16; ch++) chip.regs[REG_LED0 + 4 * ch + 3] = 0x10;   // full off
+  chip.regs[REG_PRESCALE] = 0x1E;
+}
+
+static std::map<uint8_t, BoardState> &boards() {
+  static std::map<uint8_t, BoardState> bus = [] {
+    std::map<uint8_t, BoardState> initial;
+    powerOn(initial[0x40].chip);
+    powerOn(initial[0x41].chip);
+    return initial;
+  }();
+  return bus;
+}
+
+static std::vector<HostI2cTransaction> i2cLog;
+static std::vector<HostChannelWrite> channelLog;
+static uint64_t i2cBytes = 0;
+
+HostPca9685 &hostBoard(uint8_t address) {
+  auto found = boards().find(address);
+  if (found == boards().end()) {
+    found = boards().emplace(address, BoardState()).first;
+    powerOn(found->second.chip);
+  }
+  return found->second.chip;
+}
+
+void hostRemoveBoard(uint8_t address) { boards().erase(address); }
+
+const std::vector<HostI2cTransaction> &hostI2cLog() { return i2cLog; }
+
+const std::vector<HostChannelWrite> &hostChannelWrites() { return channelLog; }
+
+void hostClearBusLog() {
+  i2cLog.clear();
+  channelLog.clear();
+}
+
+uint64_t hostI2cBytes() { return i2cBytes; }
+
+static void writeRegister(HostPca9685 &chip, uint8_t reg, uint8_t value, uint32_t &touched) {
+  if (reg >= REG_ALLLED && reg < REG_ALLLED + 4) {
+    for (int ch = 0; ch < 16; ch++) chip.regs[REG_LED0 + 4 * ch + (reg - REG_ALLLED)] = value;
+    touched = 0xFFFF;
+    return;
+  }
+  if (reg == REG_MODE1) value &= ~BIT_RESTART;   // writing 1 clears it
+  chip.regs[reg] = value;
+  if (reg >= REG_LED0 && reg < REG_LED0 + 64) touched |= 1UL << ((reg - REG_LED0) / 4);
+}
+
+static void applyWrite(uint8_t address, BoardState &board, const std::vector<uint8_t> &data) {
+  if (data.empty()) return;
+  HostPca9685 &chip = board.chip;
+  uint8_t reg = data[0];
+  uint32_t touched = 0;
+  for (size_t i = 1; i < data.size(); i++) {
+    writeRegister(chip, reg, data[i], touched);
+    if (chip.regs[REG_MODE1] & BIT_AI) reg++;
+  }
+  board.pointer = reg;
+
+  for (int ch = 0; ch < 16; ch++) {
+    if (!(touched & (1UL << ch))) continue;
+    const uint8_t *led = chip.regs + REG_LED0 + 4 * ch;
+    channelLog.push_back({hostNowUs(), address, (uint8_t)ch, (uint16_t)(led[0] | led[1] << 8),
+                          (uint16_t)(led[2] | led[3] << 8)});
+  }
+}
+
+// Boards answering an address: the one with that address, or every board
+// with all-call enabled on it
+static std::vector<std::pair<uint8_t, BoardState *>> addressed(uint8_t address) {
+  std::vector<std::pair<uint8_t, BoardState *>> targets;
+  for (auto &entry : boards()) {
+    HostPca9685 &chip = entry.second.chip;
+    if (!chip.present) continue;
+    bool allCall = (chip.regs[REG_MODE1] & BIT_ALLCALL) && chip.regs[REG_ALLCALLADR] >> 1 == address;
+    if (entry.first == address || allCall) targets.emplace_back(entry.first, &entry.second);
+  }
+  return targets;
+}
+
+bool TwoWire::begin(int sda, int scl, uint32_t frequency) { return true; }
+
+void TwoWire::beginTransmission(uint8_t address) {
+  txAddress_ = address;
+  tx_.clear();
+}
+
+size_t TwoWire::write(uint8_t data) {
+  tx_.push_back(data);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t len) {
+  tx_.insert(tx_.end(), data, data + len);
+  return len;
+}
+
+uint8_t TwoWire::endTransmission(bool sendStop) {
+  auto targets = addressed(txAddress_);
+  uint8_t result = targets.empty() ? 2 : 0;
+  for (auto &target : targets) applyWrite(target.first, *target.second, tx_);
+
+  i2cBytes += 1 + tx_.size();
+  i2cLog.push_back({hostNowUs(), txAddress_, result, tx_});
+  tx_.clear();
+  return result;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, bool sendStop) {
+  rx_.clear();
+  rxPos_ = 0;
+  auto found = boards().find(address);
+  if (found == boards().end() || !found->second.chip.present) return 0;
+
+  BoardState &board = found->second;
+  for (int i = 0; i < quantity; i++) {
+    rx_.push_back(board.chip.regs[board.pointer]);
+    if (board.chip.regs[REG_MODE1] & BIT_AI) board.pointer++;
+  }
+  i2cBytes += 1 + quantity;
+  return quantity;
+}
+
+int TwoWire::available() { return (int)(rx_.size() - rxPos_); }
+
+int TwoWire::read() { return rxPos_ < rx_.size() ? rx_[rxPos_++] : -1; }
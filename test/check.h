@@ -0,0 +1,41 @@
+// Minimal assertions for the host tests: failures are counted and printed,
+// and checkExit() turns the count into the process exit status for ctest.
+#pragma once
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+inline int &checkFailures() {
+  static int failures = 0;
+  return failures;
+}
+
+#define CHECK(cond)                                                       \
+  do {                                                                    \
+    if (!(cond)) {                                                        \
+      fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+      checkFailures()++;                                                  \
+    }                                                                     \
+  } while (0)
+
+#define CHECK_EQ(actual, expected)                                        \
+  do {                                                                    \
+    auto checkActual = (actual);                                          \
+    auto checkExpected = (expected);                                      \
+    if (!(checkActual == checkExpected)) {                                \
+      std::ostringstream checkOut;                                        \
+      checkOut << checkActual << " != " << checkExpected;                 \
+      fprintf(stderr, "%s:%d: CHECK_EQ(%s, %s) failed: %s\n", __FILE__, __LINE__, #actual, \
+              #expected, checkOut.str().c_str());                         \
+      checkFailures()++;                                                  \
+    }                                                                     \
+  } while (0)
+
+// Substring match, for JSON replies
+#define CHECK_CONTAINS(haystack, needle) CHECK(std::string(haystack).find(needle) != std::string::npos)
+
+inline int checkExit() {
+  if (checkFailures()) fprintf(stderr, "%d check(s) failed\n", checkFailures());
+  return checkFailures() ? 1 : 0;
+}
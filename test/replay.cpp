@@ -0,0 +1,256 @@
+// Trace replay regression test. Boots the firmware, replays a recorded
+// client session against it on the simulated clock, and compares every
+// PCA9685 channel write with a golden file:
+//
+//   hexapod_replay <trace> <golden> [--report <json>] [--update]
+//
+// Trace lines are "<ms> <METHOD> <url> [body]" for HTTP requests and
+// "<ms> WS <hex>" for WebSocket binary frames, at ms after the trace
+// starts; "<ms> END" sets how long to run after the last event. Lines
+// starting with # are comments. hexapod_sim --trace-out writes the HTTP
+// part of this format.
+//
+// Golden lines are "<us> <address> <channel> <on> <off>", one per channel
+// write, with us counted from the trace start. --update (or
+// HEXAPOD_UPDATE_GOLDEN=1) rewrites the golden file instead of comparing.
+//
+// The report lists per request its status, handler latency (wall clock),
+// heap allocations, and the I2C transactions and bytes up to the next
+// event, with totals. WebSocket frames report allocations and bus traffic
+// only. Only the channel writes are asserted; the rest is for comparing
+// runs.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "hexapod_host.h"
+
+#define SETTLE_MS 1000      // boot pose settles before the trace starts
+#define DEFAULT_TAIL_MS 2000
+
+struct TraceEvent {
+  uint32_t ms;
+  std::string method;    // GET, POST, ... or WS
+  std::string url;       // or the hex frame
+  std::string body;
+  int line;
+};
+
+struct RequestReport {
+  const TraceEvent *event;
+  int code;
+  uint64_t latencyNs;
+  uint64_t allocations;
+  uint64_t i2cTransactions;
+  uint64_t i2cBytes;
+};
+
+static bool loadTrace(const char *path, std::vector<TraceEvent> &events, uint32_t &endMs) {
+  std::ifstream in(path);
+  if (!in) return false;
+  std::string line;
+  int lineNo = 0;
+  endMs = 0;
+  while (std::getline(in, line)) {
+    lineNo++;
+    if (line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    TraceEvent event;
+    event.line = lineNo;
+    if (!(fields >> event.ms >> event.method)) {
+      fprintf(stderr, "%s:%d: malformed line\n", path, lineNo);
+      return false;
+    }
+    if (event.method == "END") {
+      endMs = event.ms;
+      continue;
+    }
+    fields >> event.url;
+    std::getline(fields, event.body);
+    event.body.erase(0, event.body.find_first_not_of(' '));
+    if (!events.empty() && event.ms < events.back().ms) {
+      fprintf(stderr, "%s:%d: events out of order\n", path, lineNo);
+      return false;
+    }
+    events.push_back(event);
+  }
+  if (!endMs) endMs = (events.empty() ? 0 : events.back().ms) + DEFAULT_TAIL_MS;
+  return true;
+}
+
+static std::vector<uint8_t> parseHex(const std::string &hex) {
+  std::vector<uint8_t> bytes;
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) bytes.push_back((uint8_t)strtoul(hex.substr(i, 2).c_str(), nullptr, 16));
+  return bytes;
+}
+
+static std::string jsonEscape(const std::string &s) {
+  std::string out;
+  for (char c : s) {
+    if (c == '"' || c == '\\') out += '\\';
+    if ((unsigned char)c < 0x20) {
+      out += ' ';
+      continue;
+    }
+    out += c;
+  }
+  return out;
+}
+
+static std::vector<std::string> channelLines(uint64_t startUs) {
+  std::vector<std::string> lines;
+  char buf[64];
+  for (const HostChannelWrite &write : hostChannelWrites()) {
+    snprintf(buf, sizeof(buf), "%llu %02x %u %u %u", (unsigned long long)(write.timeUs - startUs),
+             write.address, write.channel, write.on, write.off);
+    lines.push_back(buf);
+  }
+  return lines;
+}
+
+static bool writeReport(const char *path, const char *trace, const std::vector<RequestReport> &requests,
+                        size_t channelWrites, bool match) {
+  FILE *out = fopen(path, "w");
+  if (!out) return false;
+
+  uint64_t latency = 0, latencyMax = 0, allocations = 0, transactions = 0, bytes = 0;
+  fprintf(out, "{\n  \"trace\": \"%s\",\n  \"requests\": [\n", jsonEscape(trace).c_str());
+  for (size_t i = 0; i < requests.size(); i++) {
+    const RequestReport &r = requests[i];
+    fprintf(out,
+            "    {\"ms\": %u, \"method\": \"%s\", \"url\": \"%s\", \"code\": %d, \"latencyNs\": %llu, "
+            "\"allocations\": %llu, \"i2cTransactions\": %llu, \"i2cBytes\": %llu}%s\n",
+            r.event->ms, r.event->method.c_str(), jsonEscape(r.event->url).c_str(), r.code,
+            (unsigned long long)r.latencyNs, (unsigned long long)r.allocations,
+            (unsigned long long)r.i2cTransactions, (unsigned long long)r.i2cBytes,
+            i + 1 < requests.size() ? "," : "");
+    latency += r.latencyNs;
+    if (r.latencyNs > latencyMax) latencyMax = r.latencyNs;
+    allocations += r.allocations;
+    transactions += r.i2cTransactions;
+    bytes += r.i2cBytes;
+  }
+  fprintf(out,
+          "  ],\n  \"totals\": {\"requests\": %zu, \"latencyNs\": %llu, \"latencyMaxNs\": %llu, "
+          "\"allocations\": %llu, \"i2cTransactions\": %llu, \"i2cBytes\": %llu, \"channelWrites\": %zu, "
+          "\"goldenMatch\": %s}\n}\n",
+          requests.size(), (unsigned long long)latency, (unsigned long long)latencyMax,
+          (unsigned long long)allocations, (unsigned long long)transactions, (unsigned long long)bytes,
+          channelWrites, match ? "true" : "false");
+  fclose(out);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  const char *tracePath = nullptr, *goldenPath = nullptr, *reportPath = nullptr;
+  bool update = getenv("HEXAPOD_UPDATE_GOLDEN") && strcmp(getenv("HEXAPOD_UPDATE_GOLDEN"), "0") != 0;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) {
+      reportPath = argv[++i];
+    } else if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if (!tracePath) {
+      tracePath = argv[i];
+    } else if (!goldenPath) {
+      goldenPath = argv[i];
+    }
+  }
+  if (!tracePath || !goldenPath) {
+    fprintf(stderr, "usage: %s <trace> <golden> [--report <json>] [--update]\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<TraceEvent> events;
+  uint32_t endMs;
+  if (!loadTrace(tracePath, events, endMs)) {
+    fprintf(stderr, "cannot load trace %s\n", tracePath);
+    return 2;
+  }
+
+  hostBoot();
+  hostRun(SETTLE_MS);
+  hostClearBusLog();
+  uint64_t startUs = hostNowUs();
+
+  std::vector<RequestReport> requests;
+  for (const TraceEvent &event : events) {
+    uint64_t atUs = startUs + (uint64_t)event.ms * 1000;
+    if (hostNowUs() < atUs) hostRun((uint32_t)((atUs - hostNowUs() + 999) / 1000));
+
+    // Bus traffic since the previous event belongs to it
+    if (!requests.empty()) {
+      RequestReport &last = requests.back();
+      last.i2cTransactions = hostI2cLog().size() - last.i2cTransactions;
+      last.i2cBytes = hostI2cBytes() - last.i2cBytes;
+    }
+
+    RequestReport report = {&event, 0, 0, 0, hostI2cLog().size(), hostI2cBytes()};
+    if (event.method == "WS") {
+      uint64_t allocsBefore = hostAllocations();
+      hostWebSocketBinary(parseHex(event.url));
+      report.allocations = hostAllocations() - allocsBefore;
+    } else {
+      HostResponse response = hostHttp(event.method, event.url, event.body);
+      report.code = response.code;
+      report.latencyNs = response.latencyNs;
+      report.allocations = response.allocations;
+      if (response.code >= 400) {
+        fprintf(stderr, "%s:%d: %s %s -> %d %s\n", tracePath, event.line, event.method.c_str(),
+                event.url.c_str(), response.code, response.body.c_str());
+      }
+    }
+    requests.push_back(report);
+  }
+
+  uint64_t endUs = startUs + (uint64_t)endMs * 1000;
+  if (hostNowUs() < endUs) hostRun((uint32_t)((endUs - hostNowUs() + 999) / 1000));
+  if (!requests.empty()) {
+    RequestReport &last = requests.back();
+    last.i2cTransactions = hostI2cLog().size() - last.i2cTransactions;
+    last.i2cBytes = hostI2cBytes() - last.i2cBytes;
+  }
+
+  std::vector<std::string> actual = channelLines(startUs);
+  bool match = true;
+  if (update) {
+    std::ofstream out(goldenPath);
+    for (const std::string &line : actual) out << line << '\n';
+    printf("%s: wrote %zu channel writes\n", goldenPath, actual.size());
+  } else {
+    std::ifstream in(goldenPath);
+    if (!in) {
+      fprintf(stderr, "no golden file %s; run with --update to create it\n", goldenPath);
+      return 1;
+    }
+    std::vector<std::string> expected;
+    std::string line;
+    while (std::getline(in, line)) expected.push_back(line);
+
+    size_t n = actual.size() < expected.size() ? actual.size() : expected.size();
+    size_t first = n;
+    for (size_t i = 0; i < n; i++) {
+      if (actual[i] != expected[i]) {
+        first = i;
+        break;
+      }
+    }
+    if (first < n || actual.size() != expected.size()) {
+      match = false;
+      fprintf(stderr, "%s: channel writes differ from %s at write %zu of %zu (golden has %zu)\n", tracePath,
+              goldenPath, first, actual.size(), expected.size());
+      if (first < n) {
+        fprintf(stderr, "  expected: %s\n  actual:   %s\n", expected[first].c_str(), actual[first].c_str());
+      }
+    }
+  }
+
+  if (reportPath && !writeReport(reportPath, tracePath, requests, actual.size(), match)) {
+    fprintf(stderr, "cannot write report %s\n", reportPath);
+    return 1;
+  }
+  return match ? 0 : 1;
+}
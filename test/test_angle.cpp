@@ -0,0 +1,145 @@
+// Angle to PWM ticks: the per-servo lookup tables against the map() and
+// constrain() conversion they replaced.
+//  - with the default calibration every cdeg comes out within a tick of
+//    the exact linear mapping, where map() truncates whole degrees;
+//  - a trimmed, an inverted and a narrowed servo stay within a tick of
+//    their exact mapping, and the tables never step backwards;
+//  - time per conversion for both, over every cdeg and servo, with no
+//    heap use.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+#define NUM_SERVOS 18
+#define SERVO_MIN 150
+#define SERVO_MAX 600
+#define CDEG_MAX 18000
+struct ServoCal {
+  uint16_t minTicks;
+  uint16_t maxTicks;
+  int16_t trim;
+  uint8_t invert;
+  uint8_t reserved;
+};
+extern ServoCal servoCal[NUM_SERVOS];
+void calBuild(int servo);
+uint16_t angleToPWM(int servo, int cdeg);
+
+#define BENCH_PASSES 200
+
+// map() from the ESP32 Arduino core
+static long arduinoMap(long x, long inMin, long inMax, long outMin, long outMax) {
+  const long run = inMax - inMin;
+  if (run == 0) return -1;
+  return (x - inMin) * (outMax - outMin) / run + outMin;
+}
+
+// The conversion before the tables: whole degrees through map(). Kept out
+// of line, as angleToPWM() is to the test, so both pay for a call.
+__attribute__((noinline)) static uint16_t legacyAngleToPWM(int cdeg) {
+  int angle = cdeg / 100;
+  return arduinoMap(angle < 0 ? 0 : (angle > 180 ? 180 : angle), 0, 180, SERVO_MIN, SERVO_MAX);
+}
+
+// Exact pulse for a calibration, before rounding
+static double exactTicks(const ServoCal &cal, int cdeg) {
+  double angle = cal.invert ? CDEG_MAX - cdeg : cdeg;
+  angle = fmin(fmax(angle + cal.trim, 0), CDEG_MAX);
+  return cal.minTicks + (cal.maxTicks - cal.minTicks) * angle / CDEG_MAX;
+}
+
+// Worst distance from the exact pulse over every cdeg; fails on a step back
+// or a pulse past the end points. Within a degree of where a trim runs the
+// servo into its end stop, the table cuts the corner and only the end
+// points count.
+static double worstError(int servo) {
+  const ServoCal &cal = servoCal[servo];
+  double worst = 0;
+  int direction = cal.invert ? -1 : 1;
+  uint16_t last = angleToPWM(servo, 0);
+  for (int cdeg = 0; cdeg <= CDEG_MAX; cdeg++) {
+    uint16_t ticks = angleToPWM(servo, cdeg);
+    int trimmed = (cal.invert ? CDEG_MAX - cdeg : cdeg) + cal.trim;
+    bool nearStop = cal.trim && (trimmed < 100 || trimmed > CDEG_MAX - 100);
+    if (!nearStop) worst = fmax(worst, fabs(ticks - exactTicks(cal, cdeg)));
+    if (ticks < cal.minTicks || ticks > cal.maxTicks) {
+      fprintf(stderr, "servo %d: %u ticks at %d cdeg\n", servo, ticks, cdeg);
+      checkFailures()++;
+      break;
+    }
+    if (((int)ticks - last) * direction < 0) {
+      fprintf(stderr, "servo %d: %u ticks at %d cdeg after %u\n", servo, ticks, cdeg, last);
+      checkFailures()++;
+      break;
+    }
+    last = ticks;
+  }
+  return worst;
+}
+
+int main() {
+  hostBoot();
+
+  // Default calibration
+  double legacyWorst = 0;
+  for (int cdeg = 0; cdeg <= CDEG_MAX; cdeg++) {
+    legacyWorst = fmax(legacyWorst, fabs(legacyAngleToPWM(cdeg) - exactTicks(servoCal[0], cdeg)));
+  }
+  double lutWorst = worstError(0);
+  printf("angle: default calibration: table within %.2f ticks of exact, map() within %.2f\n", lutWorst,
+         legacyWorst);
+  CHECK(lutWorst <= 1.0);
+  CHECK(lutWorst < legacyWorst);
+  // Whole degrees: rounding instead of truncating moves a pulse by at most
+  // one tick
+  for (int angle = 0; angle <= 180; angle++) {
+    CHECK(abs(angleToPWM(0, angle * 100) - legacyAngleToPWM(angle * 100)) <= 1);
+  }
+
+  // Calibrated servos
+  const struct {
+    const char *name;
+    ServoCal cal;
+  } cals[] = {
+    {"trim +1.37 deg", {SERVO_MIN, SERVO_MAX, 137, 0, 0}},
+    {"trim -0.55 deg", {SERVO_MIN, SERVO_MAX, -55, 0, 0}},
+    {"inverted", {SERVO_MIN, SERVO_MAX, 0, 1, 0}},
+    {"inverted, trim", {SERVO_MIN, SERVO_MAX, 250, 1, 0}},
+    {"narrow", {200, 480, 0, 0, 0}},
+    {"wide", {102, 512, -20, 0, 0}},
+  };
+  for (const auto &c : cals) {
+    servoCal[5] = c.cal;
+    calBuild(5);
+    double worst = worstError(5);
+    printf("angle: %-15s within %.2f ticks of exact\n", c.name, worst);
+    CHECK(worst <= 1.0);
+  }
+  servoCal[5] = servoCal[0];
+  calBuild(5);
+
+  // Throughput
+  volatile uint32_t sink = 0;
+  uint64_t allocations = hostAllocations();
+  auto started = std::chrono::steady_clock::now();
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    for (int cdeg = 0; cdeg <= CDEG_MAX; cdeg++) sink = sink + angleToPWM(pass % NUM_SERVOS, cdeg);
+  }
+  double lutSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  started = std::chrono::steady_clock::now();
+  for (int pass = 0; pass < BENCH_PASSES; pass++) {
+    for (int cdeg = 0; cdeg <= CDEG_MAX; cdeg++) sink = sink + legacyAngleToPWM(cdeg);
+  }
+  double mapSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  double conversions = (double)BENCH_PASSES * (CDEG_MAX + 1);
+  printf("angle: table %.1f ns/conversion, map() %.1f ns/conversion\n", lutSeconds * 1e9 / conversions,
+         mapSeconds * 1e9 / conversions);
+  CHECK_EQ(hostAllocations(), allocations);
+
+  return checkExit();
+}
@@ -0,0 +1,170 @@
+// Body-pose controller: poses per second and what the leg cache saves.
+//  - every pose comes out exactly as solving its six feet with the leg IK
+//    from scratch would give, whether it was served from the cache or not;
+//  - poses/s for a controller with no cache (six IK solves a pose), for
+//    bodySolve() on poses that are all new, and for a pose held or rocked
+//    between a few positions, as a stick or slider at rest sends them;
+//  - the cache counts: new poses solve every leg, repeats solve none;
+//  - no heap use.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+#define NUM_LEGS 6
+#define NUM_SERVOS 18
+#define BODY_MAX_SHIFT 40
+#define BODY_MAX_TILT 2000
+#define BODY_MAX_YAW 3000
+struct BodyPose {
+  int16_t x, y, z;
+  int16_t roll, pitch, yaw;
+};
+struct BodyStats {
+  uint32_t poses;
+  uint32_t rejected;
+  uint32_t legHits;
+  uint32_t legSolves;
+  uint32_t lastUs;
+  uint32_t maxUs;
+};
+extern int16_t bodyNeutral[NUM_LEGS][3];
+extern BodyStats bodyStats;
+void bodyInit();
+bool bodySolve(const BodyPose &b, uint16_t pose[NUM_SERVOS]);
+bool ikSolveLeg(int leg, int32_t x, int32_t y, int32_t z, int16_t out[3]);
+
+#define CHECK_POSES 20000
+#define BENCH_POSES 200000
+#define ROCK_POSES 4
+
+static uint32_t rngState = 0x6C078965;
+
+static uint32_t rng() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+static int16_t within(int16_t limit) { return (int16_t)((int32_t)(rng() % (2 * limit + 1)) - limit); }
+
+static BodyPose randomPose() {
+  return {within(BODY_MAX_SHIFT), within(BODY_MAX_SHIFT), within(BODY_MAX_SHIFT),
+          within(BODY_MAX_TILT),  within(BODY_MAX_TILT),  within(BODY_MAX_YAW)};
+}
+
+// The same pose with no cache: move each planted foot into the body frame
+// and solve all six legs
+static bool solveUncached(const BodyPose &b, uint16_t pose[NUM_SERVOS]) {
+  const float k = (float)M_PI / 18000.0f;
+  float cr = cosf(b.roll * k), sr = sinf(b.roll * k);
+  float cp = cosf(b.pitch * k), sp = sinf(b.pitch * k);
+  float cy = cosf(b.yaw * k), sy = sinf(b.yaw * k);
+  const float rt[3][3] = {
+    {cy * cp, sy * cp, -sp},
+    {cy * sp * sr - sy * cr, sy * sp * sr + cy * cr, cp * sr},
+    {cy * sp * cr + sy * sr, sy * sp * cr - cy * sr, cp * cr},
+  };
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    float v[3] = {(float)(bodyNeutral[leg][0] - b.x), (float)(bodyNeutral[leg][1] - b.y),
+                  (float)(bodyNeutral[leg][2] - b.z)};
+    int32_t foot[3];
+    for (int r = 0; r < 3; r++) foot[r] = lroundf(rt[r][0] * v[0] + rt[r][1] * v[1] + rt[r][2] * v[2]);
+    int16_t joints[3];
+    if (!ikSolveLeg(leg, foot[0], foot[1], foot[2], joints)) return false;
+    for (int j = 0; j < 3; j++) {
+      if (joints[j] < 0 || joints[j] > 18000) return false;
+      pose[leg * 3 + j] = joints[j];
+    }
+  }
+  return true;
+}
+
+struct Bench {
+  double posesPerSec;
+  uint32_t legSolves;
+  uint32_t legHits;
+};
+
+// Solve n poses from the list, round robin, through solve
+template <typename Solve>
+static Bench bench(const std::vector<BodyPose> &poses, int n, Solve solve) {
+  bodyInit();
+  BodyStats before = bodyStats;
+  uint16_t pose[NUM_SERVOS];
+  volatile uint32_t sink = 0;
+  auto started = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    if (solve(poses[i % poses.size()], pose)) sink = sink + pose[i % NUM_SERVOS];
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  return {n / seconds, bodyStats.legSolves - before.legSolves, bodyStats.legHits - before.legHits};
+}
+
+int main() {
+  hostBoot();
+
+  // The cache never changes an answer
+  std::vector<BodyPose> poses;
+  for (int i = 0; i < CHECK_POSES; i++) poses.push_back(randomPose());
+  bodyInit();
+  uint32_t reachable = 0;
+  for (int i = 0; i < CHECK_POSES; i++) {
+    // Every other pose is a recent one again, so both paths are checked
+    const BodyPose &b = i % 2 ? poses[i - 1 - rng() % (i < 8 ? 1 : 4)] : poses[i];
+    uint16_t cached[NUM_SERVOS], fresh[NUM_SERVOS];
+    memset(cached, 0xAA, sizeof(cached));
+    bool ok = bodySolve(b, cached);
+    bool freshOk = solveUncached(b, fresh);
+    reachable += ok;
+    if (ok != freshOk || (ok && memcmp(cached, fresh, sizeof(cached)) != 0)) {
+      fprintf(stderr, "pose %d %d %d / %d %d %d: cache %s, fresh %s\n", b.x, b.y, b.z, b.roll, b.pitch, b.yaw,
+              ok ? "ok" : "rejected", freshOk ? "ok" : "rejected");
+      checkFailures()++;
+      break;
+    }
+  }
+  printf("body: %d poses checked against fresh IK, %u reachable\n", CHECK_POSES, reachable);
+  CHECK(reachable > CHECK_POSES / 2);
+
+  // Throughput. Only reachable poses, so each one solves all six legs.
+  std::vector<BodyPose> fresh;
+  uint16_t scratch[NUM_SERVOS];
+  while (fresh.size() < BENCH_POSES) {
+    BodyPose b = randomPose();
+    if (solveUncached(b, scratch)) fresh.push_back(b);
+  }
+  std::vector<BodyPose> held(fresh.begin(), fresh.begin() + 1);
+  std::vector<BodyPose> rocking(fresh.begin(), fresh.begin() + ROCK_POSES);
+
+  uint64_t allocations = hostAllocations();
+  Bench uncached = bench(fresh, BENCH_POSES, solveUncached);
+  Bench cold = bench(fresh, BENCH_POSES, bodySolve);
+  Bench hold = bench(held, BENCH_POSES, bodySolve);
+  Bench rock = bench(rocking, BENCH_POSES, bodySolve);
+  CHECK_EQ(hostAllocations(), allocations);
+
+  printf("body: no cache       %8.0f poses/s\n", uncached.posesPerSec);
+  printf("body: new poses      %8.0f poses/s, %u leg solves, %u hits\n", cold.posesPerSec, cold.legSolves,
+         cold.legHits);
+  printf("body: held pose      %8.0f poses/s, %u leg solves, %u hits\n", hold.posesPerSec, hold.legSolves,
+         hold.legHits);
+  printf("body: rocking (%d)    %8.0f poses/s, %u leg solves, %u hits\n", ROCK_POSES, rock.posesPerSec,
+         rock.legSolves, rock.legHits);
+  CHECK_EQ(uncached.legSolves + uncached.legHits, 0u);
+  // New poses: a leg's target almost always moves by a millimetre or more
+  CHECK(cold.legSolves >= (uint32_t)BENCH_POSES * NUM_LEGS * 9 / 10);
+  // Held and rocking: the first round solves, after that only hits
+  CHECK_EQ(hold.legSolves, (uint32_t)NUM_LEGS);
+  CHECK(rock.legSolves <= (uint32_t)ROCK_POSES * NUM_LEGS);
+  CHECK_EQ(hold.legSolves + hold.legHits, (uint32_t)BENCH_POSES * NUM_LEGS);
+  CHECK_EQ(rock.legSolves + rock.legHits, (uint32_t)BENCH_POSES * NUM_LEGS);
+
+  return checkExit();
+}
@@ -0,0 +1,111 @@
+// I2C cost of a frame: the firmware's bursts over runs of adjacent dirty
+// channels against one setPWM() transaction per channel, as the sketch used
+// to write. Counts
+// transactions and bytes on the simulated bus and converts them to bus time
+// at 400 kHz, for a full 18-joint frame, a single joint and one tripod
+// group, and then for the frames of a real pose move.
+#include <Adafruit_PWMServoDriver.h>
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+#define NUM_SERVOS 18
+extern uint16_t frameTicks[NUM_SERVOS];
+void setFrameTicks(int servo, uint16_t ticks);
+void commitFrame();
+
+// Joint to board and channel, as servoMap in the sketch
+static uint8_t jointAddress(int servo) { return servo < 16 ? 0x40 : 0x41; }
+static uint8_t jointChannel(int servo) { return servo % 16; }
+
+#define BUS_HZ 400000
+
+struct BusCost {
+  uint64_t transactions = 0;
+  uint64_t bytes = 0;
+
+  // Start, 9 bits per byte with its ACK, stop
+  double busUs() const { return (transactions * 2 + bytes * 9) * 1e6 / BUS_HZ; }
+};
+
+static BusCost busCost() {
+  BusCost cost;
+  for (const HostI2cTransaction &t : hostI2cLog()) {
+    cost.transactions++;
+    cost.bytes += 1 + t.data.size();   // address, register, data
+  }
+  return cost;
+}
+
+static uint16_t pulse(uint16_t on, uint16_t off) { return (off - on) & 0x0FFF; }
+
+static void report(const char *frame, const BusCost &burst, const BusCost &perChannel) {
+  printf("bus: %-14s burst %3llu transactions %4llu bytes %7.1f us | per channel %3llu transactions %4llu "
+         "bytes %7.1f us\n",
+         frame, (unsigned long long)burst.transactions, (unsigned long long)burst.bytes, burst.busUs(),
+         (unsigned long long)perChannel.transactions, (unsigned long long)perChannel.bytes, perChannel.busUs());
+}
+
+// Write the same change both ways and compare; returns the burst cost
+static BusCost compare(const char *frame, const std::vector<int> &joints, uint16_t ticks) {
+  hostClearBusLog();
+  for (int servo : joints) setFrameTicks(servo, ticks);
+  commitFrame();
+  BusCost burst = busCost();
+
+  static Adafruit_PWMServoDriver boards[] = {Adafruit_PWMServoDriver(0x40), Adafruit_PWMServoDriver(0x41)};
+  hostClearBusLog();
+  for (int servo : joints) boards[jointAddress(servo) - 0x40].setPWM(jointChannel(servo), 0, frameTicks[servo]);
+  BusCost perChannel = busCost();
+
+  report(frame, burst, perChannel);
+  CHECK_EQ(perChannel.transactions, (uint64_t)joints.size());
+  CHECK(burst.transactions <= perChannel.transactions);
+  CHECK(burst.busUs() <= perChannel.busUs());
+  return burst;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  std::vector<int> all;
+  for (int i = 0; i < NUM_SERVOS; i++) all.push_back(i);
+  // A full frame is one burst per board
+  CHECK_EQ(compare("18 joints", all, 300).transactions, 2u);
+  compare("1 joint", {4}, 320);
+  compare("tripod group", {0, 1, 2, 6, 7, 8, 12, 13, 14}, 340);
+
+  // A real move: each motion tick writes its changed channels, against one
+  // transaction per changed channel
+  hostRun(100);
+  std::map<int, uint16_t> last;
+  for (int servo = 0; servo < NUM_SERVOS; servo++) {
+    const uint8_t *led = hostBoard(jointAddress(servo)).regs + PCA9685_LED0_ON_L + 4 * jointChannel(servo);
+    last[jointAddress(servo) << 8 | jointChannel(servo)] = pulse(led[0] | led[1] << 8, led[2] | led[3] << 8);
+  }
+  hostClearBusLog();
+  CHECK_EQ(hostHttp("POST", "/pose/crouch?duration=1000").code, 200);
+  hostRun(1200);
+  BusCost burst = busCost();
+  BusCost perChannel;
+  for (const HostChannelWrite &write : hostChannelWrites()) {
+    int key = write.address << 8 | write.channel;
+    uint16_t value = pulse(write.on, write.off);
+    if (last[key] == value) continue;
+    last[key] = value;
+    perChannel.transactions++;
+    perChannel.bytes += 6;
+  }
+  report("pose move", burst, perChannel);
+  CHECK(burst.transactions > 0);
+  CHECK(burst.transactions < perChannel.transactions);
+  CHECK(burst.busUs() < perChannel.busUs());
+
+  return checkExit();
+}
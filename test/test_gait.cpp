@@ -0,0 +1,58 @@
+// Gait changes: switching gait while walking settles on the neutral stance
+// before the new gait starts, while a new speed for the same gait keeps
+// the legs in step.
+#include <cstdlib>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+static std::vector<int> positions() {
+  std::string body = hostHttp("GET", "/getPositions").body;
+  std::vector<int> out;
+  size_t at = body.find('[');
+  while (at != std::string::npos && body[at] != ']') {
+    out.push_back(atoi(body.c_str() + at + 1));
+    at = body.find_first_of(",]", at + 1);
+  }
+  return out;
+}
+
+static int maxDiff(const std::vector<int> &a, const std::vector<int> &b) {
+  int worst = 0;
+  for (size_t i = 0; i < a.size() && i < b.size(); i++) worst = std::max(worst, abs(a[i] - b[i]));
+  return worst;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  // Neutral stance, as left by stopping
+  CHECK_EQ(hostHttp("POST", "/gait", "{\"gait\":\"tripod\",\"vx\":100}").code, 200);
+  hostRun(1000);
+  CHECK_EQ(hostHttp("POST", "/gait", "{\"gait\":\"stop\"}").code, 200);
+  hostRun(1500);
+  std::vector<int> neutral = positions();
+  CHECK_EQ(neutral.size(), (size_t)18);
+
+  // Mid-walk the legs are well away from it
+  CHECK_EQ(hostHttp("POST", "/gait", "{\"gait\":\"tripod\",\"vx\":100}").code, 200);
+  hostRun(1730);
+  std::vector<int> walking = positions();
+  CHECK(maxDiff(walking, neutral) > 5);
+
+  // Same gait, new speed: no detour through the stance
+  CHECK_EQ(hostHttp("POST", "/gait", "{\"gait\":\"tripod\",\"vx\":60}").code, 200);
+  hostRun(400);
+  CHECK(maxDiff(positions(), neutral) > 5);
+
+  // New gait: back to the stance first, then walking again
+  CHECK_EQ(hostHttp("POST", "/gait", "{\"gait\":\"wave\",\"vx\":100}").code, 200);
+  hostRun(410);
+  CHECK(maxDiff(positions(), neutral) <= 2);
+  hostRun(1500);
+  CHECK(maxDiff(positions(), neutral) > 2);
+
+  return checkExit();
+}
@@ -0,0 +1,52 @@
+// Boots the firmware on the host and checks the PCA9685 bring-up, a REST
+// round trip and that a move reaches both boards on the simulated clock.
+#include <set>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+static uint16_t pulseWidth(uint8_t address, int channel) {
+  const uint8_t *led = hostBoard(address).regs + 0x06 + 4 * channel;
+  uint16_t on = led[0] | (led[1] & 0x0F) << 8;
+  uint16_t off = led[2] | (led[3] & 0x0F) << 8;
+  return (off - on) & 0x0FFF;
+}
+
+int main() {
+  hostBoot();
+
+  // Both boards awake with auto-increment and all-call, at 50 Hz
+  for (uint8_t address : {0x40, 0x41}) {
+    const HostPca9685 &board = hostBoard(address);
+    CHECK_EQ(board.regs[0x00] & 0x10, 0);      // SLEEP
+    CHECK_EQ(board.regs[0x00] & 0x20, 0x20);   // AI
+    CHECK_EQ(board.regs[0x00] & 0x01, 0x01);   // ALLCALL
+    CHECK_EQ((int)board.regs[0xFE], 131);      // 27 MHz / (4096 * 50 Hz) - 1
+  }
+
+  HostResponse ping = hostHttp("GET", "/ping");
+  CHECK_EQ(ping.code, 200);
+  CHECK_CONTAINS(ping.body, "\"status\":\"ok\"");
+  CHECK_EQ(hostHttp("GET", "/nowhere").code, 404);
+
+  hostRun(100);
+  uint16_t centered = pulseWidth(0x40, 0);
+  CHECK(centered > 0);
+
+  hostClearBusLog();
+  HostResponse setAll = hostHttp("POST", "/setAll", "{\"angle\":45}");
+  CHECK_EQ(setAll.code, 200);
+  CHECK(setAll.allocations > 0);
+  hostRun(3000);
+
+  std::set<uint8_t> reached;
+  for (const HostChannelWrite &write : hostChannelWrites()) reached.insert(write.address);
+  CHECK(reached.count(0x40) && reached.count(0x41));
+  CHECK(pulseWidth(0x40, 0) < centered);
+
+  HostResponse positions = hostHttp("GET", "/getPositions");
+  CHECK_EQ(positions.code, 200);
+  CHECK_CONTAINS(positions.body, "[45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45]");
+
+  return checkExit();
+}
@@ -0,0 +1,127 @@
+// Leg IK against a double-precision reference: worst and mean joint error
+// over each leg's workspace, and solves per second. Fails if the error
+// exceeds the bounds below.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Same layout as the sketch, to read its default geometry
+#define NUM_LEGS 6
+struct LegMount {
+  int16_t x, y;
+  int16_t angle;
+};
+struct LegGeometry {
+  int16_t coxaLen, femurLen, tibiaLen;
+  int16_t coxaZero, femurZero, tibiaZero;
+  int8_t coxaDir, femurDir, tibiaDir;
+  LegMount legs[NUM_LEGS];
+};
+extern LegGeometry legGeometry;
+bool ikSolveLeg(int leg, int32_t x, int32_t y, int32_t z, int16_t out[3]);
+
+#define WORKSPACE_MAX_ERR_DEG 0.05   // hip-to-foot distance 70..175 mm
+#define NEAR_REACH_MAX_ERR_DEG 0.15  // beyond that, up to 0.5 mm short of full reach
+
+struct Target {
+  int leg;
+  int32_t x, y, z;
+  double joints[3];   // reference, cdeg
+  double d;           // hip-to-foot distance, mm
+};
+
+static double rad(double cdeg) { return cdeg * M_PI / 18000.0; }
+static double cdeg(double rad) { return rad * 18000.0 / M_PI; }
+
+// The same solve in double precision; false when out of reach
+static bool referenceSolve(const Target &t, double out[3], double &d) {
+  const LegGeometry &g = legGeometry;
+  const LegMount &m = g.legs[t.leg];
+  double a = rad(m.angle);
+  double dx = t.x - m.x, dy = t.y - m.y;
+  double lx = dx * cos(a) + dy * sin(a);
+  double ly = dy * cos(a) - dx * sin(a);
+  double r = hypot(lx, ly) - g.coxaLen;
+  d = hypot(r, (double)t.z);
+  double f = g.femurLen, l = g.tibiaLen;
+  if (d > f + l || d < fabs(f - l)) return false;
+  double femur = atan2((double)t.z, r) + acos((f * f + d * d - l * l) / (2 * f * d));
+  double knee = acos((f * f + l * l - d * d) / (2 * f * l));
+  out[0] = g.coxaZero + g.coxaDir * cdeg(atan2(ly, lx));
+  out[1] = g.femurZero + g.femurDir * cdeg(femur);
+  out[2] = g.tibiaZero + g.tibiaDir * (cdeg(knee) - 9000);
+  return true;
+}
+
+int main() {
+  hostBoot();
+  const LegGeometry &g = legGeometry;
+
+  // Feet fanned +-40 deg around each leg, out to full reach, -150..60 mm high
+  std::vector<Target> targets;
+  for (int leg = 0; leg < NUM_LEGS; leg++) {
+    const LegMount &m = g.legs[leg];
+    for (int fan = -4000; fan <= 4000; fan += 500) {
+      double a = rad(m.angle + fan);
+      for (int reach = g.coxaLen + 20; reach <= g.coxaLen + g.femurLen + g.tibiaLen; reach += 2) {
+        for (int z = -150; z <= 60; z += 3) {
+          Target t = {leg, (int32_t)lround(m.x + reach * cos(a)), (int32_t)lround(m.y + reach * sin(a)), z, {}, 0};
+          if (referenceSolve(t, t.joints, t.d)) targets.push_back(t);
+        }
+      }
+    }
+  }
+  CHECK(targets.size() > 10000);
+
+  double workMax = 0, workSum = 0, nearMax = 0;
+  size_t workCount = 0;
+  const Target *worst = nullptr;
+  int unsolved = 0;
+  for (const Target &t : targets) {
+    int16_t out[3];
+    if (!ikSolveLeg(t.leg, t.x, t.y, t.z, out)) {
+      // Allowed only where rounding puts the foot on the reach boundary
+      if (t.d < g.femurLen + g.tibiaLen - 0.5) unsolved++;
+      continue;
+    }
+    double err = 0;
+    for (int j = 0; j < 3; j++) err = fmax(err, fabs(out[j] - t.joints[j]) / 100.0);
+    if (t.d >= 70 && t.d <= 175) {
+      workSum += err;
+      workCount++;
+      if (err > workMax) {
+        workMax = err;
+        worst = &t;
+      }
+    } else if (t.d > 175 && t.d <= g.femurLen + g.tibiaLen - 0.5) {
+      nearMax = fmax(nearMax, err);
+    }
+  }
+
+  // Throughput over the whole target set
+  const int rounds = 20;
+  int16_t out[3];
+  uint32_t sink = 0;
+  auto started = std::chrono::steady_clock::now();
+  for (int round = 0; round < rounds; round++) {
+    for (const Target &t : targets) {
+      ikSolveLeg(t.leg, t.x, t.y, t.z, out);
+      sink += out[1];
+    }
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  printf("ik: %zu targets, workspace max %.3f deg mean %.4f deg, near reach max %.3f deg\n", targets.size(),
+         workMax, workSum / workCount, nearMax);
+  printf("ik: %.0f solves/s on this host (%u)\n", rounds * targets.size() / seconds, sink & 1);
+  if (worst) printf("ik: worst at leg %d (%d, %d, %d) d=%.1f\n", worst->leg, worst->x, worst->y, worst->z, worst->d);
+
+  CHECK_EQ(unsolved, 0);
+  CHECK(workMax < WORKSPACE_MAX_ERR_DEG);
+  CHECK(nearMax < NEAR_REACH_MAX_ERR_DEG);
+  return checkExit();
+}
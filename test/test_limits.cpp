@@ -0,0 +1,27 @@
+// Output limiter current budget: a budget that cannot pay one joint's start
+// surge is refused, and the smallest accepted budget still completes a move.
+#include "check.h"
+#include "hexapod_host.h"
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"jointMa\":700,\"budgetMa\":500}").code, 400);
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"jointMa\":6000}").code, 400);   // over the range
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"budgetMa\":600}").code, 400);   // below the default jointMa
+  CHECK_CONTAINS(hostHttp("GET", "/limits").body, "\"jointMa\":700,\"budgetMa\":5000");
+
+  // One start surge at a time: every joint still gets there
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"jointMa\":700,\"budgetMa\":700}").code, 200);
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"jointMa\":800}").code, 400);
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":45}").code, 200);
+  hostRun(15000);
+  CHECK_CONTAINS(hostHttp("GET", "/getPositions").body,
+                 "\"positions\":[45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45,45]");
+
+  // 0 turns the budget off whatever jointMa is
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"jointMa\":900,\"budgetMa\":0}").code, 200);
+
+  return checkExit();
+}
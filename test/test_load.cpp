@@ -0,0 +1,196 @@
+// HTTP load against hexapod_sim over loopback TCP: 1, 4 and 16 clients
+// each loop over a mix of /ping, /getPositions and /setServo for a while,
+// one request per connection as the dashboard makes them. Reports
+// requests per second and latency quantiles per level, and fails if any
+// request errors out. A 503 from /setServo is the command ring pushing
+// back (the motion task drains it at 100 Hz); it is counted, not failed.
+//
+//   test_load path/to/hexapod_sim
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+
+extern char **environ;
+
+#define LEVEL_MS 2000
+
+typedef std::chrono::steady_clock Clock;
+
+static int freePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  bind(fd, (sockaddr *)&addr, sizeof(addr));
+  getsockname(fd, (sockaddr *)&addr, &len);
+  close(fd);
+  return ntohs(addr.sin_port);
+}
+
+static int connectTo(int port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(port);
+  if (connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// One request on its own connection; the status code, or 0 on a
+// connection error
+static int roundTrip(int port, const std::string &method, const std::string &url, const std::string &body) {
+  int fd = connectTo(port);
+  if (fd < 0) return 0;
+  std::string out = method + " " + url + " HTTP/1.1\r\nHost: 127.0.0.1\r\n";
+  if (!body.empty()) out += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+  out += "Connection: close\r\n\r\n" + body;
+  if (send(fd, out.data(), out.size(), MSG_NOSIGNAL) != (ssize_t)out.size()) {
+    close(fd);
+    return 0;
+  }
+
+  std::string in;
+  char buf[2048];
+  ssize_t n;
+  while ((n = recv(fd, buf, sizeof(buf), 0)) > 0) in.append(buf, n);
+  close(fd);
+  if (in.compare(0, 9, "HTTP/1.1 ") != 0) return 0;
+  return atoi(in.c_str() + 9);
+}
+
+struct Level {
+  int clients;
+  uint64_t requests;
+  double seconds;
+  double p50Ms, p99Ms, maxMs;
+  uint64_t shed;
+  uint64_t failed;
+};
+
+static Level runLevel(int port, int clients) {
+  std::mutex lock;
+  std::vector<double> latencies;
+  std::atomic<uint64_t> shed{0}, failed{0};
+  auto started = Clock::now();
+  auto until = started + std::chrono::milliseconds(LEVEL_MS);
+
+  std::vector<std::thread> threads;
+  for (int c = 0; c < clients; c++) {
+    threads.emplace_back([&, c] {
+      std::vector<double> mine;
+      for (int i = 0; Clock::now() < until; i++) {
+        auto sent = Clock::now();
+        int code;
+        bool command = false;
+        switch (i % 3) {
+          case 0:
+            code = roundTrip(port, "GET", "/ping", "");
+            break;
+          case 1:
+            code = roundTrip(port, "GET", "/getPositions", "");
+            break;
+          default:
+            command = true;
+            code = roundTrip(port, "POST", "/setServo",
+                             "{\"servo\":" + std::to_string(c % 18) + ",\"angle\":" + std::to_string(60 + i % 60) + "}");
+            break;
+        }
+        mine.push_back(std::chrono::duration<double, std::milli>(Clock::now() - sent).count());
+        if (command && code == 503)
+          shed++;
+        else if (code != 200)
+          failed++;
+      }
+      std::lock_guard<std::mutex> guard(lock);
+      latencies.insert(latencies.end(), mine.begin(), mine.end());
+    });
+  }
+  for (std::thread &thread : threads) thread.join();
+
+  Level level = {};
+  level.clients = clients;
+  level.requests = latencies.size();
+  level.seconds = std::chrono::duration<double>(Clock::now() - started).count();
+  level.shed = shed;
+  level.failed = failed;
+  if (!latencies.empty()) {
+    std::sort(latencies.begin(), latencies.end());
+    level.p50Ms = latencies[latencies.size() / 2];
+    level.p99Ms = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    level.maxMs = latencies.back();
+  }
+  return level;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s path/to/hexapod_sim\n", argv[0]);
+    return 2;
+  }
+
+  // The simulator is stopped with a signal, so give it a partition this
+  // test cleans up
+  std::string fsRoot = (std::filesystem::temp_directory_path() / "hexapod-load-XXXXXX").string();
+  if (!mkdtemp(&fsRoot[0])) {
+    perror("mkdtemp");
+    return 1;
+  }
+  setenv("HEXAPOD_FS_ROOT", fsRoot.c_str(), 1);
+
+  int port = freePort();
+  std::string portArg = std::to_string(port);
+  char *simArgv[] = {argv[1], (char *)"--port", &portArg[0], nullptr};
+  pid_t sim;
+  if (posix_spawn(&sim, argv[1], nullptr, nullptr, simArgv, environ) != 0) {
+    perror("posix_spawn");
+    return 1;
+  }
+
+  // Wait for it to come up
+  auto deadline = Clock::now() + std::chrono::seconds(10);
+  while (roundTrip(port, "GET", "/ping", "") != 200 && Clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  CHECK_EQ(roundTrip(port, "GET", "/ping", ""), 200);
+
+  if (!checkFailures()) {
+    for (int clients : {1, 4, 16}) {
+      Level level = runLevel(port, clients);
+      printf("load: %2d clients: %llu requests in %.2f s, %.0f req/s, p50 %.2f ms, p99 %.2f ms, max %.2f ms, "
+             "%llu shed, %llu failed\n",
+             level.clients, (unsigned long long)level.requests, level.seconds, level.requests / level.seconds,
+             level.p50Ms, level.p99Ms, level.maxMs, (unsigned long long)level.shed,
+             (unsigned long long)level.failed);
+      CHECK(level.requests > 0);
+      CHECK_EQ(level.failed, 0u);
+    }
+  }
+
+  kill(sim, SIGTERM);
+  waitpid(sim, nullptr, 0);
+  std::error_code ec;
+  std::filesystem::remove_all(fsRoot, ec);
+  return checkExit();
+}
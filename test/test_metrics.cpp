@@ -0,0 +1,169 @@
+// Latency histograms behind /metrics, fed from a fake clock.
+//  - every duration lands in a bucket whose limit is at or above it and
+//    within a quarter of it, and the buckets never go backwards;
+//  - quantiles read from the histogram are never below the exact quantile
+//    of the samples and at most one bucket above it, for a spread of
+//    distributions, and never past the largest sample;
+//  - durations taken across the 32-bit micros() wrap come out right;
+//  - /metrics reports what was recorded, and loop() is timed once a pass
+//    on the simulated clock.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+enum MetricId : uint8_t {
+  METRIC_LOOP,
+  METRIC_MOTION_TICK,
+  METRIC_I2C_COMMIT,
+  METRIC_SET_SERVO,
+  METRIC_SET_ALL,
+  METRIC_SWEEP,
+  METRIC_UPDATE,
+  METRIC_COUNT
+};
+#define HIST_BUCKETS 96
+struct LatencyHist {
+  uint32_t count;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+  uint32_t buckets[HIST_BUCKETS];
+};
+extern LatencyHist metrics[METRIC_COUNT];
+int histBucket(uint32_t us);
+uint32_t histBucketLimit(int idx);
+void metricRecord(MetricId id, uint32_t us);
+uint32_t histQuantile(const LatencyHist &h, uint32_t perMille);
+
+#define SAMPLES 100000
+
+static uint32_t rngState = 0x2545F491;
+
+static uint32_t rng() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+// A clock that only moves when told to, wrapping as micros() does
+struct FakeClock {
+  uint32_t nowUs;
+  uint32_t micros() const { return nowUs; }
+  void advance(uint32_t us) { nowUs += us; }
+};
+
+// Time one span on the fake clock the way MetricScope does
+static void timeSpan(FakeClock &clock, MetricId id, uint32_t durationUs) {
+  uint32_t start = clock.micros();
+  clock.advance(durationUs);
+  metricRecord(id, clock.micros() - start);
+}
+
+static uint32_t exactQuantile(std::vector<uint32_t> sorted, uint32_t perMille) {
+  size_t rank = ((uint64_t)sorted.size() * perMille + 999) / 1000;
+  return sorted[rank ? rank - 1 : 0];
+}
+
+static std::string metricLine(const std::string &body, const std::string &name) {
+  size_t at = body.find(name + " ");
+  return at == std::string::npos ? "" : body.substr(at + name.size() + 1, body.find('\n', at) - at - name.size() - 1);
+}
+
+int main() {
+  // Buckets
+  int lastBucket = 0;
+  for (uint32_t us = 0; us < 1u << 22; us += 1 + us / 64) {
+    int bucket = histBucket(us);
+    uint32_t limit = histBucketLimit(bucket);
+    if (bucket < lastBucket || us > limit || (bucket > 0 && us <= histBucketLimit(bucket - 1)) ||
+        limit - us > us / 4 + 1) {
+      fprintf(stderr, "%u us: bucket %d, limit %u, previous limit %u\n", us, bucket, limit,
+              bucket ? histBucketLimit(bucket - 1) : 0);
+      checkFailures()++;
+      break;
+    }
+    lastBucket = bucket;
+  }
+  // Each limit is the last value of its bucket
+  for (int bucket = 0; bucket < HIST_BUCKETS - 1; bucket++) {
+    uint32_t limit = histBucketLimit(bucket);
+    if (histBucket(limit) != bucket || histBucket(limit + 1) != bucket + 1) {
+      fprintf(stderr, "bucket %d: limit %u falls in %d, %u in %d\n", bucket, limit, histBucket(limit), limit + 1,
+              histBucket(limit + 1));
+      checkFailures()++;
+    }
+  }
+  CHECK_EQ(histBucket(0xFFFFFFFF), HIST_BUCKETS - 1);
+
+  // Quantiles against the exact ones, over a fake clock started just
+  // short of the wrap so the spans straddle it
+  const struct {
+    const char *name;
+    uint32_t (*sample)();
+  } distributions[] = {
+    {"constant", [] { return (uint32_t)250; }},
+    {"uniform", [] { return rng() % 20000; }},
+    {"bimodal", [] { return rng() % 10 ? 40 + rng() % 20 : 9000 + rng() % 3000; }},
+    {"long tail", [] { return (uint32_t)(1u << (rng() % 20)) + rng() % 1024; }},
+  };
+  for (const auto &dist : distributions) {
+    FakeClock clock = {0xFFFFFFFF - 1000000};
+    memset(&metrics[METRIC_SWEEP], 0, sizeof(LatencyHist));
+    std::vector<uint32_t> samples;
+    uint64_t sum = 0;
+    for (int i = 0; i < SAMPLES; i++) {
+      uint32_t us = dist.sample();
+      samples.push_back(us);
+      sum += us;
+      timeSpan(clock, METRIC_SWEEP, us);
+      clock.advance(rng() % 100);   // idle between spans
+    }
+    std::sort(samples.begin(), samples.end());
+    const LatencyHist &h = metrics[METRIC_SWEEP];
+    CHECK_EQ(h.count, (uint32_t)SAMPLES);
+    CHECK_EQ(h.sumUs, sum);
+    CHECK_EQ(h.minUs, samples.front());
+    CHECK_EQ(h.maxUs, samples.back());
+    for (uint32_t perMille : {1, 500, 900, 990, 999, 1000}) {
+      uint32_t exact = exactQuantile(samples, perMille);
+      uint32_t estimate = histQuantile(h, perMille);
+      if (estimate < exact || estimate > histBucketLimit(histBucket(exact)) || estimate > h.maxUs) {
+        fprintf(stderr, "%s: q%u exact %u, histogram %u\n", dist.name, perMille, exact, estimate);
+        checkFailures()++;
+      }
+    }
+    printf("metrics: %-9s p50 %6u (exact %6u) p99 %6u (exact %6u) max %6u\n", dist.name, histQuantile(h, 500),
+           exactQuantile(samples, 500), histQuantile(h, 990), exactQuantile(samples, 990), h.maxUs);
+  }
+  memset(&metrics[METRIC_SWEEP], 0, sizeof(LatencyHist));
+  CHECK_EQ(histQuantile(metrics[METRIC_SWEEP], 990), 0u);
+
+  // The scrape shows what was recorded
+  hostBoot();
+  FakeClock clock = {0};
+  for (uint32_t us : {100, 200, 300, 400, 5000}) timeSpan(clock, METRIC_SWEEP, us);
+  std::string body = hostHttp("GET", "/metrics").body;
+  CHECK_EQ(metricLine(body, "hexapod_latency_us_count{path=\"sweep\"}"), "5");
+  CHECK_EQ(metricLine(body, "hexapod_latency_us_sum{path=\"sweep\"}"), "6000");
+  CHECK_EQ(metricLine(body, "hexapod_latency_min_us{path=\"sweep\"}"), "100");
+  CHECK_EQ(metricLine(body, "hexapod_latency_max_us{path=\"sweep\"}"), "5000");
+  CHECK_EQ(metricLine(body, "hexapod_latency_avg_us{path=\"sweep\"}"), "1200");
+  CHECK_EQ(metricLine(body, "hexapod_latency_us{path=\"sweep\",quantile=\"0.99\"}"), "5000");
+
+  // loop() on the simulated clock: one sample per 1 ms pass, and nothing
+  // inside the timed part moves the clock
+  uint32_t loops = metrics[METRIC_LOOP].count;
+  hostRun(100);
+  CHECK_EQ(metrics[METRIC_LOOP].count - loops, 100u);
+  CHECK_EQ(metrics[METRIC_LOOP].maxUs, 0u);
+
+  return checkExit();
+}
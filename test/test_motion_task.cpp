@@ -0,0 +1,55 @@
+// The firmware's own configuration: the motion task on its own thread,
+// on the wall clock, while requests are served from this one. Joint
+// commands and status reads go on for a couple of seconds; the tick has to
+// keep its rate and every command has to reach the PWM within a few ticks.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+#define MOTION_TICK_US 10000
+#define RUN_MS 2000
+
+static unsigned field(const std::string &json, const char *name) {
+  size_t at = json.find(std::string("\"") + name + "\":");
+  return at == std::string::npos ? 0 : strtoul(json.c_str() + at + strlen(name) + 3, nullptr, 10);
+}
+
+int main() {
+  hostSetRealtime(true);
+  hostBoot();
+  hostRun(100);
+
+  unsigned ticksBefore = field(hostHttp("GET", "/motion").body, "ticks");
+  auto started = std::chrono::steady_clock::now();
+  int requests = 0, failed = 0;
+  while (std::chrono::steady_clock::now() - started < std::chrono::milliseconds(RUN_MS)) {
+    char body[48];
+    snprintf(body, sizeof(body), "{\"servo\":%d,\"cdeg\":%d}", requests % 18, 4500 + requests % 9000);
+    if (hostHttp("POST", "/setServo", body).code != 200) failed++;
+    if (hostHttp("GET", "/motion").code != 200) failed++;
+    if (hostHttp("GET", "/phase").code != 200) failed++;
+    requests++;
+    hostRun(1);
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  std::string motion = hostHttp("GET", "/motion").body;
+  unsigned ticks = field(motion, "ticks") - ticksBefore;
+  unsigned expected = seconds * 1e6 / MOTION_TICK_US;
+  printf("motion task: %u ticks in %.2f s (%u expected), %u overruns, late max %u us, "
+         "cmd latency avg %u us max %u us, %d requests\n",
+         ticks, seconds, expected, field(motion, "overruns"), field(motion, "lateMaxUs"),
+         field(motion, "cmdLatAvgUs"), field(motion, "cmdLatMaxUs"), requests);
+
+  CHECK_EQ(failed, 0);
+  CHECK(ticks >= expected * 9 / 10 && ticks <= expected + 2);
+  CHECK_EQ(field(motion, "cmdDropped"), 0u);
+  // A tick plus generous scheduling slack for a loaded build machine
+  CHECK(field(motion, "cmdLatMaxUs") < 5 * MOTION_TICK_US);
+
+  return checkExit();
+}
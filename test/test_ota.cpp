@@ -0,0 +1,114 @@
+// Browser OTA: chunked uploads through Update with the SHA-256 check,
+// corrupt images and a client that goes away mid-upload, plus an espota
+// session that fails. Every failure leaves the robot held in the sit pose
+// with its outputs driven, and motion commands work again afterwards.
+#include <Update.h>
+#include <mbedtls/sha256.h>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+#define IMAGE_BYTES (64 * 1024)
+#define CHUNK_BYTES 1436    // one TCP segment per upload callback
+
+static std::string sha256Hex(const std::string &data) {
+  mbedtls_sha256_context ctx;
+  uint8_t digest[32];
+  mbedtls_sha256_init(&ctx);
+  mbedtls_sha256_starts(&ctx, 0);
+  mbedtls_sha256_update(&ctx, (const uint8_t *)data.data(), data.size());
+  mbedtls_sha256_finish(&ctx, digest);
+  mbedtls_sha256_free(&ctx);
+  char hex[65];
+  for (int i = 0; i < 32; i++) snprintf(hex + 2 * i, 3, "%02x", digest[i]);
+  return hex;
+}
+
+static std::string positionsOf(const std::string &json) {
+  size_t at = json.find("\"positions\":[");
+  return at == std::string::npos ? "" : json.substr(at, json.find(']', at) - at + 1);
+}
+
+// Every servo output is still pulsing, not released
+static bool outputsDriven() {
+  int driven = 0;
+  for (uint8_t address : {0x40, 0x41}) {
+    for (int ch = 0; ch < 16; ch++) {
+      const uint8_t *led = hostBoard(address).regs + 0x06 + 4 * ch;
+      uint16_t on = led[0] | (led[1] & 0x0F) << 8;
+      uint16_t off = led[2] | (led[3] & 0x0F) << 8;
+      bool fullOff = led[3] & 0x10;
+      driven += !fullOff && ((off - on) & 0x0FFF) != 0;
+    }
+  }
+  return driven == 18;
+}
+
+// Leave the sit pose, so the hold has somewhere to go
+static void standUp() {
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":60}").code, 200);
+  hostRun(3000);
+}
+
+static void checkHeldAndRecovers(const std::string &sit, const char *status) {
+  hostRun(3000);
+  CHECK_EQ(positionsOf(hostHttp("GET", "/getPositions").body), sit);
+  CHECK(outputsDriven());
+  CHECK_CONTAINS(hostHttp("GET", "/ping").body, status);
+  CHECK(!hostRestartRequested());
+  CHECK_EQ(hostHttp("POST", "/setServo", "{\"servo\":0,\"angle\":90}").code, 200);
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  std::string image(IMAGE_BYTES, '\0');
+  for (size_t i = 0; i < image.size(); i++) image[i] = (char)(i * 131 + (i >> 8));
+  std::string digest = sha256Hex(image);
+
+  HostResponse sit = hostHttp("GET", "/sit");
+  std::string sitPositions = positionsOf(sit.body);
+  CHECK(!sitPositions.empty());
+
+  // Digest that cannot match
+  standUp();
+  HostResponse response = hostUpload("/update?sha256=00", image, CHUNK_BYTES, 5);
+  CHECK_EQ(response.code, 500);
+  CHECK(!Update.finished());
+  checkHeldAndRecovers(sitPositions, "SHA-256 mismatch");
+
+  // One flipped bit against the right digest, given as a header
+  standUp();
+  std::string corrupt = image;
+  corrupt[IMAGE_BYTES / 2] ^= 0x10;
+  response = hostUpload("/update", corrupt, CHUNK_BYTES, 5, SIZE_MAX, {{"X-Image-SHA256", digest}});
+  CHECK_EQ(response.code, 500);
+  CHECK(!Update.finished());
+  checkHeldAndRecovers(sitPositions, "SHA-256 mismatch");
+
+  // Client gone halfway: no reply, partition abandoned
+  standUp();
+  response = hostUpload("/update?sha256=" + digest, image, CHUNK_BYTES, 5, IMAGE_BYTES / 2);
+  CHECK_EQ(response.code, 0);
+  CHECK(!Update.finished());
+  CHECK(!Update.isRunning());
+  checkHeldAndRecovers(sitPositions, "Upload aborted");
+
+  // espota session that dies part way
+  standUp();
+  hostOtaSession(IMAGE_BYTES, true);
+  checkHeldAndRecovers(sitPositions, "Receive Failed");
+
+  // Good image, in chunks, with its digest: restart is scheduled, not immediate
+  standUp();
+  response = hostUpload("/update?sha256=" + digest, image, CHUNK_BYTES, 5);
+  CHECK_EQ(response.code, 200);
+  CHECK(Update.finished());
+  CHECK(Update.image() == image);
+  CHECK(!hostRestartRequested());
+  hostRun(1100);
+  CHECK(hostRestartRequested());
+
+  return checkExit();
+}
@@ -0,0 +1,226 @@
+// Request body parser: fuzzing and throughput.
+//  - well-formed bodies with random values have to come back with exactly
+//    those values;
+//  - a few hundred thousand mutations of them (flipped, inserted, dropped
+//    and truncated bytes, spliced bodies, random bytes) must never read
+//    outside the body or hand out a field that breaks its schema. Each body
+//    sits in a buffer of its own exact size, so under
+//    -fsanitize=address,undefined a stray read is caught;
+//  - no parse may touch the heap;
+//  - parses per second for a typical /setServo body.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+enum ReqFieldType : uint8_t { FIELD_INT, FIELD_STR };
+enum ParseResult : uint8_t { PARSE_OK, PARSE_MALFORMED, PARSE_MISSING, PARSE_RANGE };
+#define REQ_STR_LEN 12
+struct ReqField {
+  const char *key;
+  ReqFieldType type;
+  bool required;
+  int32_t minVal, maxVal;
+  bool seen;
+  int32_t intVal;
+  char strVal[REQ_STR_LEN];
+};
+ParseResult parseRequest(const char *body, size_t bodyLen, ReqField *fields, size_t count);
+
+#define ROUND_TRIPS 20000
+#define MUTATIONS 300000
+#define THROUGHPUT_PARSES 2000000
+
+static uint32_t rngState = 0x9E3779B9;
+
+static uint32_t rng() {
+  rngState ^= rngState << 13;
+  rngState ^= rngState >> 17;
+  rngState ^= rngState << 5;
+  return rngState;
+}
+
+// The schema every body is parsed against: two bounded ints, an optional
+// negative-capable int and a string
+static void schema(ReqField *fields) {
+  fields[0] = {"servo", FIELD_INT, true, 0, 17};
+  fields[1] = {"cdeg", FIELD_INT, false, 0, 18000};
+  fields[2] = {"trim", FIELD_INT, false, -500, 500};
+  fields[3] = {"name", FIELD_STR, false};
+}
+#define FIELD_COUNT 4
+
+static const char *const seeds[] = {
+  "{\"servo\":3,\"cdeg\":9000}",
+  "{ \"servo\" : 17 , \"trim\" : -40 , \"name\" : \"perch\" }",
+  "{\"name\":\"hop_1\",\"servo\":0,\"extra\":true,\"more\":null,\"off\":false}",
+  "{\"servo\":5,\"ignored\":\"long string that is not one of ours\",\"cdeg\":0}",
+  "\r\n\t{\"servo\":12}\n",
+  "{}",
+};
+#define SEED_COUNT (sizeof(seeds) / sizeof(seeds[0]))
+
+// Parse from a heap buffer holding exactly the body, no terminator
+static ParseResult parseExact(const std::string &body, ReqField *fields) {
+  char *exact = (char *)malloc(body.size() ? body.size() : 1);
+  memcpy(exact, body.data(), body.size());
+  uint64_t allocations = hostAllocations();
+  ParseResult result = parseRequest(exact, body.size(), fields, FIELD_COUNT);
+  if (hostAllocations() != allocations) {
+    fprintf(stderr, "parse allocated: %s\n", body.c_str());
+    checkFailures()++;
+  }
+  free(exact);
+  return result;
+}
+
+// Whatever the input, an accepted parse keeps every field inside its schema
+static bool fieldsValid(const ReqField *fields) {
+  for (int f = 0; f < FIELD_COUNT; f++) {
+    const ReqField &field = fields[f];
+    if (field.required && !field.seen) return false;
+    if (!field.seen) continue;
+    if (field.type == FIELD_INT && (field.intVal < field.minVal || field.intVal > field.maxVal)) return false;
+    if (field.type == FIELD_STR) {
+      size_t len = strnlen(field.strVal, REQ_STR_LEN);
+      if (len == REQ_STR_LEN || strpbrk(field.strVal, "\"\\")) return false;
+    }
+  }
+  return true;
+}
+
+static std::string mutate(std::string body) {
+  int edits = 1 + rng() % 4;
+  for (int e = 0; e < edits; e++) {
+    size_t at = body.empty() ? 0 : rng() % body.size();
+    switch (rng() % 6) {
+      case 0:
+        if (!body.empty()) body[at] ^= 1 << (rng() % 8);
+        break;
+      case 1:
+        body.insert(body.begin() + at, "{}[]:,\"\\-0.9eE tn"[rng() % 17]);
+        break;
+      case 2:
+        if (!body.empty()) body.erase(at, 1 + rng() % 3);
+        break;
+      case 3:
+        body.resize(at);
+        break;
+      case 4:
+        body.insert(at, seeds[rng() % SEED_COUNT]);
+        break;
+      default:
+        if (!body.empty()) body[at] = (char)rng();
+        break;
+    }
+  }
+  return body;
+}
+
+int main() {
+  ReqField fields[FIELD_COUNT];
+
+  // Round trips
+  for (int i = 0; i < ROUND_TRIPS; i++) {
+    int servo = rng() % 18, cdeg = rng() % 18001, trim = (int)(rng() % 1001) - 500;
+    char name[REQ_STR_LEN];
+    int nameLen = 1 + rng() % (REQ_STR_LEN - 1);
+    for (int c = 0; c < nameLen; c++) name[c] = "abcdefghijklmnopqrstuvwxyz0123456789_-"[rng() % 38];
+    name[nameLen] = '\0';
+    char body[128];
+    snprintf(body, sizeof(body), "{\"name\":\"%s\", \"trim\":%d,\"cdeg\" :%d ,\"servo\":%d}", name, trim, cdeg,
+             servo);
+    schema(fields);
+    if (parseExact(body, fields) != PARSE_OK || fields[0].intVal != servo || fields[1].intVal != cdeg ||
+        fields[2].intVal != trim || strcmp(fields[3].strVal, name) != 0) {
+      fprintf(stderr, "round trip: %s\n", body);
+      checkFailures()++;
+      break;
+    }
+  }
+
+  // Inputs the parser has to turn away
+  const struct {
+    const char *body;
+    ParseResult result;
+  } rejects[] = {
+    {"", PARSE_MALFORMED},
+    {"{", PARSE_MALFORMED},
+    {"{\"servo\":3", PARSE_MALFORMED},
+    {"{\"servo\":3}x", PARSE_MALFORMED},
+    {"{\"servo\":3.5}", PARSE_MALFORMED},
+    {"{\"servo\":3e1}", PARSE_MALFORMED},
+    {"{\"servo\":-}", PARSE_MALFORMED},
+    {"{\"servo\":\"3\"}", PARSE_MALFORMED},
+    {"{\"servo\":3,,\"cdeg\":1}", PARSE_MALFORMED},
+    {"{\"servo\":3,\"x\":[1]}", PARSE_MALFORMED},
+    {"{\"servo\":3,\"x\":{}}", PARSE_MALFORMED},
+    {"{\"servo\":3,\"name\":\"a\\\"b\"}", PARSE_MALFORMED},
+    {"{\"servo\":3,\"cdeg\":true}", PARSE_MALFORMED},
+    {"{\"cdeg\":9000}", PARSE_MISSING},
+    {"{\"servo\":18}", PARSE_RANGE},
+    {"{\"servo\":99999999999}", PARSE_RANGE},
+    {"{\"servo\":1,\"trim\":-501}", PARSE_RANGE},
+    {"{\"servo\":1,\"name\":\"twelve_chars\"}", PARSE_RANGE},
+  };
+  for (const auto &reject : rejects) {
+    schema(fields);
+    ParseResult result = parseExact(reject.body, fields);
+    if (result != reject.result) fprintf(stderr, "%s: got %d\n", reject.body, result);
+    CHECK_EQ(result, reject.result);
+  }
+
+  // Mutations
+  uint32_t accepted = 0, results[4] = {};
+  for (int i = 0; i < MUTATIONS; i++) {
+    std::string body = rng() % 16 ? mutate(seeds[rng() % SEED_COUNT]) : std::string(rng() % 64, '\0');
+    if (body.find('\0') != std::string::npos) {
+      for (char &c : body) c = (char)rng();
+    }
+    schema(fields);
+    ParseResult result = parseExact(body, fields);
+    if (result > PARSE_RANGE) {
+      fprintf(stderr, "unknown result %d\n", result);
+      checkFailures()++;
+      break;
+    }
+    results[result]++;
+    if (result == PARSE_OK) {
+      accepted++;
+      if (!fieldsValid(fields)) {
+        fprintf(stderr, "accepted an invalid field: %s\n", body.c_str());
+        checkFailures()++;
+        break;
+      }
+    }
+  }
+  printf("parse: %d mutations: %u ok, %u malformed, %u missing, %u out of range\n", MUTATIONS, results[PARSE_OK],
+         results[PARSE_MALFORMED], results[PARSE_MISSING], results[PARSE_RANGE]);
+  // The mix has to reach every outcome to mean anything
+  for (uint32_t count : results) CHECK(count > 0);
+
+  // Throughput
+  const char *typical = "{\"servo\":7,\"cdeg\":12345}";
+  size_t typicalLen = strlen(typical);
+  uint64_t allocations = hostAllocations();
+  uint32_t ok = 0;
+  auto started = std::chrono::steady_clock::now();
+  for (int i = 0; i < THROUGHPUT_PARSES; i++) {
+    schema(fields);
+    ok += parseRequest(typical, typicalLen, fields, FIELD_COUNT) == PARSE_OK;
+  }
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  printf("parse: %d parses of %zu bytes in %.2f s, %.0f/s, %.0f MB/s, %llu allocations\n", THROUGHPUT_PARSES,
+         typicalLen, seconds, THROUGHPUT_PARSES / seconds, THROUGHPUT_PARSES * typicalLen / seconds / 1e6,
+         (unsigned long long)(hostAllocations() - allocations));
+  CHECK_EQ(ok, (uint32_t)THROUGHPUT_PARSES);
+  CHECK_EQ(hostAllocations(), allocations);
+
+  return checkExit();
+}
@@ -0,0 +1,77 @@
+// Handlers run under apiLock, so they must not wait on flash: every
+// request that changes a setting or a sequence file leaves the write to
+// loop(). Checks that no handler touches LittleFS or NVS, and that the
+// change is on flash once loop() has run.
+#include <Preferences.h>
+#include <sys/stat.h>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Serve a request and fail if the handler itself went to flash
+static HostResponse request(const std::string &method, const std::string &url, const std::string &body = "") {
+  uint64_t before = hostFlashOps();
+  HostResponse response = hostHttp(method, url, body);
+  if (hostFlashOps() != before) {
+    fprintf(stderr, "%s %s: %llu flash operations in the handler\n", method.c_str(), url.c_str(),
+            (unsigned long long)(hostFlashOps() - before));
+    checkFailures()++;
+  }
+  return response;
+}
+
+static bool sequenceFile(const char *name) {
+  struct stat info;
+  return stat((hostFsRoot() + "/seq/" + name + ".hxr").c_str(), &info) == 0;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  Preferences nvs;
+  nvs.begin("hexapod", true);
+
+  CHECK_EQ(request("POST", "/phase", "{\"phaseStep\":300}").code, 200);
+  CHECK_EQ(request("POST", "/calibration", "{\"servo\":2,\"trim\":-40}").code, 200);
+  CHECK_EQ(request("POST", "/pose/save", "{\"name\":\"perch\"}").code, 200);
+  CHECK(!nvs.isKey("pose0"));
+  hostRun(5);
+  CHECK_EQ(nvs.getUShort("phaseStep"), 300);
+  CHECK(nvs.isKey("pose0"));
+  CHECK(nvs.getBytesLength("cal") > 0);
+
+  CHECK_EQ(request("POST", "/pose/delete", "{\"name\":\"perch\"}").code, 200);
+  hostRun(5);
+  CHECK(!nvs.isKey("pose0"));
+
+  // Record, stop, list and delete a sequence
+  CHECK_EQ(request("POST", "/sequence/record", "{\"name\":\"hop\"}").code, 200);
+  hostRun(5);
+  CHECK(sequenceFile("hop"));
+  CHECK_EQ(request("POST", "/setAll", "{\"angle\":60}").code, 200);
+  hostRun(1000);
+  CHECK_CONTAINS(request("POST", "/sequence/stop").body, "\"state\":\"stopping\"");
+  hostRun(5);
+  CHECK_CONTAINS(request("GET", "/sequence").body, "\"state\":\"idle\"");
+  CHECK_CONTAINS(request("GET", "/sequence").body, "\"files\":[{\"name\":\"hop\"");
+  CHECK_EQ(request("POST", "/sequence/delete", "{\"name\":\"hop\"}").code, 200);
+  CHECK_CONTAINS(request("GET", "/sequence").body, "\"files\":[]");
+  CHECK_EQ(request("POST", "/sequence/delete", "{\"name\":\"hop\"}").code, 404);
+  hostRun(5);
+  CHECK(!sequenceFile("hop"));
+
+  // A recording under a name deleted a moment ago is not removed with it
+  CHECK_EQ(request("POST", "/sequence/record", "{\"name\":\"spin\"}").code, 200);
+  request("POST", "/sequence/stop");
+  hostRun(5);
+  CHECK_EQ(request("POST", "/sequence/delete", "{\"name\":\"spin\"}").code, 200);
+  CHECK_EQ(request("POST", "/sequence/record", "{\"name\":\"spin\"}").code, 200);
+  hostRun(5);
+  request("POST", "/sequence/stop");
+  hostRun(5);
+  CHECK(sequenceFile("spin"));
+  CHECK_CONTAINS(request("GET", "/sequence").body, "\"files\":[{\"name\":\"spin\"");
+
+  return checkExit();
+}
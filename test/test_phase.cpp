@@ -0,0 +1,115 @@
+// Pulse phase stagger: how many servo pulses are high at once. The model
+// reads the ON/OFF registers the firmware left in the simulated PCA9685s
+// and plays one PWM period of each board count by count, as the chip
+// would: high from ON up to OFF, wrapping into the next period when OFF is
+// below ON, and low when the two are equal. Compared before (phaseStep 0,
+// every pulse starting at count 0) and after (the default stagger) for the
+// rest pose, a crouch and every servo at full travel:
+//  - each channel is still high for exactly its pulse width;
+//  - the peak on one clock matches what GET /phase reports;
+//  - the two boards run from their own oscillators and drift against each
+//    other, so the worst case over the bus is the sum of the boards' peaks.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+#define NUM_SERVOS 18
+#define PCA9685_PERIOD 4096
+#define PCA9685_LED0_ON_L 0x06
+#define PHASE_DEFAULT_STEP (PCA9685_PERIOD / NUM_SERVOS)
+
+// Joint to board and channel, as servoMap in the sketch
+static uint8_t jointAddress(int servo) { return servo < 16 ? 0x40 : 0x41; }
+static uint8_t jointChannel(int servo) { return servo % 16; }
+
+struct PeakModel {
+  int peak;          // most pulses high at once, boards on one clock
+  int boardPeak[2];  // most pulses high at once on each board
+  int worst;         // boards drifted to line their peaks up
+  bool widthsMatch;  // every channel high for its pulse width
+};
+
+static unsigned field(const std::string &json, const char *name) {
+  size_t at = json.find(std::string("\"") + name + "\":");
+  return at == std::string::npos ? 0 : strtoul(json.c_str() + at + strlen(name) + 3, nullptr, 10);
+}
+
+static uint16_t reg16(const uint8_t *regs, int at) { return regs[at] | regs[at + 1] << 8; }
+
+static PeakModel model() {
+  static int high[2][PCA9685_PERIOD];
+  memset(high, 0, sizeof(high));
+  PeakModel m = {0, {0, 0}, 0, true};
+  for (int servo = 0; servo < NUM_SERVOS; servo++) {
+    int board = jointAddress(servo) - 0x40;
+    const uint8_t *led = hostBoard(jointAddress(servo)).regs + PCA9685_LED0_ON_L + 4 * jointChannel(servo);
+    uint16_t on = reg16(led, 0) & 0x0FFF, off = reg16(led, 2) & 0x0FFF;
+    int width = 0;
+    for (int count = 0; count < PCA9685_PERIOD; count++) {
+      bool isHigh = on < off ? count >= on && count < off : on > off && (count >= on || count < off);
+      if (isHigh) {
+        high[board][count]++;
+        width++;
+      }
+    }
+    if (width != ((off - on) & 0x0FFF)) {
+      fprintf(stderr, "servo %d: ON %u OFF %u high for %d counts\n", servo, on, off, width);
+      m.widthsMatch = false;
+    }
+  }
+  for (int count = 0; count < PCA9685_PERIOD; count++) {
+    m.peak = std::max(m.peak, high[0][count] + high[1][count]);
+    for (int board = 0; board < 2; board++) m.boardPeak[board] = std::max(m.boardPeak[board], high[board][count]);
+  }
+  m.worst = m.boardPeak[0] + m.boardPeak[1];
+  return m;
+}
+
+static PeakModel measure(const char *pose, uint16_t step) {
+  char body[32];
+  snprintf(body, sizeof(body), "{\"phaseStep\":%u}", step);
+  CHECK_EQ(hostHttp("POST", "/phase", body).code, 200);
+  hostRun(50);
+  PeakModel m = model();
+  CHECK(m.widthsMatch);
+  // The firmware's own figure assumes one clock
+  CHECK_EQ(m.peak, (int)field(hostHttp("GET", "/phase").body, "peakPulses"));
+  printf("phase: %-10s step %3u: peak %2d on one clock (0x40 %2d, 0x41 %d), %2d with the boards drifted\n", pose,
+         step, m.peak, m.boardPeak[0], m.boardPeak[1], m.worst);
+  return m;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"maxVel\":0,\"maxAccel\":0,\"budgetMa\":0}").code, 200);
+
+  const struct {
+    const char *name;
+    const char *method, *url, *body;
+  } poses[] = {
+    {"rest", "POST", "/setAll", "{\"angle\":90}"},
+    {"crouch", "POST", "/pose/crouch?duration=100", ""},
+    {"full", "POST", "/setAll", "{\"angle\":180}"},
+  };
+  for (const auto &pose : poses) {
+    CHECK_EQ(hostHttp(pose.method, pose.url, pose.body).code, 200);
+    hostRun(300);
+    PeakModel aligned = measure(pose.name, 0);
+    PeakModel staggered = measure(pose.name, PHASE_DEFAULT_STEP);
+    // Aligned, every pulse is high together at count 0
+    CHECK_EQ(aligned.peak, NUM_SERVOS);
+    CHECK_EQ(aligned.worst, NUM_SERVOS);
+    // Staggered, a pulse of at most 600 counts overlaps two neighbours
+    CHECK(staggered.peak <= 3);
+    CHECK(staggered.boardPeak[1] <= 2);
+    CHECK(staggered.worst <= 5);
+  }
+
+  return checkExit();
+}
@@ -0,0 +1,88 @@
+// Slow moves come out of the PCA9685s one tick at a time. Joints are kept
+// in cdeg down to the PWM, so a ramp slower than a tick per frame must
+// step every channel by at most one tick between writes, always the same
+// way, rather than in whole-degree jumps of two or three ticks. Checked for
+// a long pose transition and for a /setServo ramp in cdeg.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+struct ChannelTrace {
+  uint16_t first = 0, last = 0;
+  int direction = 0;
+  uint32_t writes = 0;
+  uint32_t jumps = 0;       // steps of more than one tick
+  uint32_t reversals = 0;
+};
+
+static uint16_t pulse(const HostChannelWrite &write) { return (write.off - write.on) & 0x0FFF; }
+
+// Follow every channel through the bus log since the last clear
+static std::map<int, ChannelTrace> traceChannels() {
+  std::map<int, ChannelTrace> traces;
+  for (const HostChannelWrite &write : hostChannelWrites()) {
+    ChannelTrace &trace = traces[write.address << 8 | write.channel];
+    uint16_t ticks = pulse(write);
+    if (trace.writes++ == 0) {
+      trace.first = trace.last = ticks;
+      continue;
+    }
+    int step = (int)ticks - trace.last;
+    if (abs(step) > 1) trace.jumps++;
+    if (step) {
+      int direction = step > 0 ? 1 : -1;
+      if (trace.direction && direction != trace.direction) trace.reversals++;
+      trace.direction = direction;
+    }
+    trace.last = ticks;
+  }
+  return traces;
+}
+
+// Fail on any jump or reversal; returns the widest span a channel covered
+static int checkSmooth(const char *ramp) {
+  int widest = 0;
+  for (const auto &entry : traceChannels()) {
+    const ChannelTrace &trace = entry.second;
+    if (trace.jumps || trace.reversals) {
+      fprintf(stderr, "%s: board 0x%02x channel %d: %u jumps, %u reversals\n", ramp, entry.first >> 8,
+              entry.first & 0xFF, trace.jumps, trace.reversals);
+    }
+    CHECK_EQ(trace.jumps, 0u);
+    CHECK_EQ(trace.reversals, 0u);
+    widest = std::max(widest, abs((int)trace.last - trace.first));
+  }
+  printf("ramp: %s: %zu channels, widest %d ticks\n", ramp, traceChannels().size(), widest);
+  return widest;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  // Rest to crouch over ten seconds: the tibias cross about 55 degrees,
+  // well over a hundred ticks, and peak at a fraction of a tick per frame
+  hostClearBusLog();
+  CHECK_EQ(hostHttp("POST", "/pose/crouch?duration=10000").code, 200);
+  hostRun(10500);
+  CHECK(checkSmooth("pose") > 100);
+
+  // One joint by 0.2 degrees per frame from the wire, about half a tick
+  CHECK_EQ(hostHttp("POST", "/setServo", "{\"servo\":0,\"cdeg\":4500}").code, 200);
+  hostRun(2000);
+  hostClearBusLog();
+  for (int cdeg = 4500; cdeg <= 9000; cdeg += 20) {
+    char body[48];
+    snprintf(body, sizeof(body), "{\"servo\":0,\"cdeg\":%d}", cdeg);
+    CHECK_EQ(hostHttp("POST", "/setServo", body).code, 200);
+    hostRun(10);
+  }
+  hostRun(500);
+  CHECK(checkSmooth("cdeg") > 100);
+
+  return checkExit();
+}
@@ -0,0 +1,50 @@
+// Release: POST /release switches every output off with a single all-call
+// write, the outputs stay off while idle, and the next move drives them.
+#include "check.h"
+#include "hexapod_host.h"
+
+static bool channelOff(const HostPca9685 &board, int channel) {
+  const uint8_t *led = board.regs + 0x06 + 4 * channel;
+  return led[0] == 0 && led[1] == 0 && led[2] == 0 && led[3] == 0;
+}
+
+static int offChannels(uint8_t address) {
+  int off = 0;
+  for (int ch = 0; ch < 16; ch++) off += channelOff(hostBoard(address), ch);
+  return off;
+}
+
+int main() {
+  hostBoot();
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":45}").code, 200);
+  hostRun(3000);
+  CHECK(offChannels(0x40) < 16);
+
+  // One transaction to the all-call address, nothing to the boards
+  hostClearBusLog();
+  CHECK_EQ(hostHttp("POST", "/release").code, 200);
+  hostRun(20);
+  const std::vector<HostI2cTransaction> &log = hostI2cLog();
+  CHECK_EQ(log.size(), (size_t)1);
+  if (!log.empty()) {
+    CHECK_EQ((int)log[0].address, 0x70);
+    CHECK_EQ((int)log[0].result, 0);
+    CHECK_EQ(log[0].data.size(), (size_t)5);   // ALL_LED_ON_L, ON = OFF = 0
+  }
+  CHECK_EQ(offChannels(0x40), 16);
+  CHECK_EQ(offChannels(0x41), 16);
+
+  // Nothing re-drives them while idle
+  hostRun(2000);
+  CHECK_EQ(hostI2cLog().size(), (size_t)1);
+  CHECK_EQ(offChannels(0x40), 16);
+  CHECK_EQ(offChannels(0x41), 16);
+  CHECK_CONTAINS(hostHttp("GET", "/metrics").body, "hexapod_i2c_board_transactions_total{board=\"0x70\"} 1\n");
+
+  // A joint command drives that joint again; the others stay limp
+  CHECK_EQ(hostHttp("POST", "/setServo", "{\"servo\":0,\"angle\":90}").code, 200);
+  hostRun(2000);
+  CHECK_EQ(offChannels(0x40) + offChannels(0x41), 31);
+
+  return checkExit();
+}
@@ -0,0 +1,120 @@
+// JSON responders: bytes and heap allocations per request. The responders
+// that build into the static response buffer must cost no more
+// allocations than a reply sent from a string literal, which is the
+// server's own per-request floor. The position serializer is also set
+// against the String += build it replaced, without the server around it.
+#include <Arduino.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+#define NUM_SERVOS 18
+extern char responseBuf[];
+void respBegin();
+void respRaw(const char *text);
+void respPositions(const uint16_t *cdeg);
+
+#define OPS 20
+#define SERIALIZE_OPS 10000
+
+struct Route {
+  const char *method;
+  const char *url;
+  uint32_t settleMs;    // let queued motion finish between requests
+};
+
+struct PerOp {
+  double allocations;
+  double bytes;
+  int failures;
+};
+
+static PerOp measure(const Route &route) {
+  PerOp result = {0, 0, 0};
+  for (int i = 0; i < OPS; i++) {
+    hostRun(route.settleMs);
+    HostResponse response = hostHttp(route.method, route.url);
+    if (response.code != 200) result.failures++;
+    result.allocations += response.allocations;
+    result.bytes += response.body.size();
+  }
+  result.allocations /= OPS;
+  result.bytes /= OPS;
+  return result;
+}
+
+// The /getPositions body as it used to be built, one String += per joint
+static size_t serializeString(const uint16_t *degrees) {
+  String json = "{\"positions\":[";
+  for (int i = 0; i < NUM_SERVOS; i++) {
+    json += String(degrees[i]);
+    if (i < NUM_SERVOS - 1) json += ",";
+  }
+  json += "]}";
+  return json.length();
+}
+
+static size_t serializeBuffer(const uint16_t *cdeg) {
+  respBegin();
+  respRaw("{");
+  respPositions(cdeg);
+  respRaw("}");
+  return strlen(responseBuf);
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  // Serializers alone, over the same pose
+  {
+    uint16_t cdeg[NUM_SERVOS], degrees[NUM_SERVOS];
+    for (int i = 0; i < NUM_SERVOS; i++) {
+      degrees[i] = 20 + i * 8;
+      cdeg[i] = degrees[i] * 100;
+    }
+    uint64_t before = hostAllocations();
+    size_t stringBytes = 0;
+    for (int i = 0; i < SERIALIZE_OPS; i++) stringBytes += serializeString(degrees);
+    uint64_t stringAllocations = hostAllocations() - before;
+    before = hostAllocations();
+    size_t bufferBytes = 0;
+    for (int i = 0; i < SERIALIZE_OPS; i++) bufferBytes += serializeBuffer(cdeg);
+    uint64_t bufferAllocations = hostAllocations() - before;
+
+    printf("%-14s %6.1f allocs/op %7.1f bytes/op (String +=, before)\n", "positions",
+           (double)stringAllocations / SERIALIZE_OPS, (double)stringBytes / SERIALIZE_OPS);
+    printf("%-14s %6.1f allocs/op %7.1f bytes/op (response buffer)\n", "positions",
+           (double)bufferAllocations / SERIALIZE_OPS, (double)bufferBytes / SERIALIZE_OPS);
+    CHECK_EQ(bufferBytes, stringBytes);
+    CHECK_EQ(bufferAllocations, 0u);
+    CHECK(stringAllocations > 0);
+  }
+
+  // Literal reply: {"status":"success","action":"release"}
+  PerOp floor = measure({"POST", "/release", 10});
+  printf("%-14s %6.1f allocs/op %7.1f bytes/op (floor)\n", "/release", floor.allocations, floor.bytes);
+  CHECK_EQ(floor.failures, 0);
+
+  const Route routes[] = {
+    {"GET", "/ping", 10},
+    {"GET", "/getPositions", 10},
+    {"GET", "/stand", 2500},
+    {"GET", "/sit", 2500},
+    {"POST", "/sweep", 4500},
+    {"GET", "/motion", 10},
+  };
+  for (const Route &route : routes) {
+    PerOp op = measure(route);
+    printf("%-14s %6.1f allocs/op %7.1f bytes/op\n", route.url, op.allocations, op.bytes);
+    CHECK_EQ(op.failures, 0);
+    CHECK(op.allocations <= floor.allocations);
+  }
+
+  CHECK_CONTAINS(hostHttp("POST", "/sweep").body, "{\"status\":\"success\",\"job\":");
+  return checkExit();
+}
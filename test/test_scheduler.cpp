@@ -0,0 +1,109 @@
+// Motion scheduler on the simulated clock:
+//  - loop() ticks the motion at exactly 100 Hz with no lateness beyond the
+//    loop's own 1 ms period;
+//  - a stall longer than a period is reported as an overrun and late tick,
+//    and the schedule resyncs instead of bursting through the missed ticks;
+//  - a move is queued by the handler without the clock moving, answered
+//    with a job id, and done once its keyframes have played out;
+//  - pose transitions follow the minimum-jerk profile.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+#define MOTION_TICK_US 10000
+#define LOOP_PERIOD_US 1000
+#define SWEEP_MS 3900   // 39 keyframes of 100 ms
+
+static unsigned field(const std::string &json, const char *name) {
+  size_t at = json.find(std::string("\"") + name + "\":");
+  return at == std::string::npos ? 0 : strtoul(json.c_str() + at + strlen(name) + 3, nullptr, 10);
+}
+
+static unsigned motion(const char *name) { return field(hostHttp("GET", "/motion").body, name); }
+
+static std::vector<int> positionsCdeg() {
+  std::string body = hostHttp("GET", "/getPositions").body;
+  std::vector<int> out;
+  size_t at = body.find('[', body.find("\"positionsCdeg\""));
+  while (at != std::string::npos && body[at] != ']') {
+    out.push_back(atoi(body.c_str() + at + 1));
+    at = body.find_first_of(",]", at + 1);
+  }
+  return out;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  // Steady rate
+  unsigned ticks = motion("ticks");
+  hostRun(2000);
+  unsigned steady = motion("ticks") - ticks;
+  printf("scheduler: %u ticks in 2000 ms, late max %u us, %u overruns\n", steady, motion("lateMaxUs"),
+         motion("overruns"));
+  CHECK_EQ(steady, 200u);
+  CHECK_EQ(motion("overruns"), 0u);
+  CHECK(motion("lateMaxUs") < LOOP_PERIOD_US);
+
+  // A 45 ms stall in loop(): one late tick, then back on a 10 ms grid
+  ticks = motion("ticks");
+  hostAdvanceUs(45000);
+  hostRun(100);
+  unsigned afterStall = motion("ticks") - ticks;
+  printf("scheduler: 45 ms stall: %u ticks over the next 145 ms, late max %u us, %u overruns\n", afterStall,
+         motion("lateMaxUs"), motion("overruns"));
+  CHECK_EQ(motion("overruns"), 1u);
+  CHECK(motion("lateMaxUs") >= 35000 && motion("lateMaxUs") <= 45000 + LOOP_PERIOD_US);
+  CHECK(afterStall >= 10 && afterStall <= 11);
+
+  // The handler queues the sweep and returns at once
+  uint64_t before = hostNowUs();
+  HostResponse sweep = hostHttp("POST", "/sweep");
+  CHECK_EQ(sweep.code, 200);
+  CHECK_EQ(hostNowUs(), before);
+  unsigned job = field(sweep.body, "job");
+  CHECK(job > 0);
+  hostRun(20);
+  CHECK_EQ(motion("activeJob"), job);
+  CHECK_EQ(hostHttp("GET", "/ping").code, 200);
+  uint32_t ranMs = 20;
+  while (motion("lastDoneJob") != job && ranMs < 2 * SWEEP_MS) {
+    hostRun(10);
+    ranMs += 10;
+  }
+  printf("scheduler: sweep job %u done after %u ms\n", job, ranMs);
+  CHECK_EQ(motion("lastDoneJob"), job);
+  CHECK(ranMs >= SWEEP_MS && ranMs <= SWEEP_MS + 100);
+
+  // Minimum jerk: a quarter of the way through the time, about a tenth of
+  // the way there (t^3 (10 - 15t + 6t^2) = 0.104); halfway at half time
+  hostRun(1000);
+  std::vector<int> start = positionsCdeg();
+  CHECK_EQ(hostHttp("POST", "/pose/crouch?duration=2000").code, 200);
+  hostRun(500);
+  std::vector<int> quarter = positionsCdeg();
+  hostRun(500);
+  std::vector<int> half = positionsCdeg();
+  hostRun(1500);
+  std::vector<int> end = positionsCdeg();
+  CHECK_EQ(start.size(), (size_t)18);
+  CHECK_EQ(end.size(), (size_t)18);
+  for (size_t i = 1; i < start.size() && i < end.size(); i += 3) {   // femurs
+    int span = end[i] - start[i];
+    int quarterExpected = start[i] + span * 104 / 1000;
+    int halfExpected = start[i] + span / 2;
+    if (abs(quarter[i] - quarterExpected) > 100 || abs(half[i] - halfExpected) > 100) {
+      fprintf(stderr, "joint %zu: %d -> %d, at 1/4 %d (want %d), at 1/2 %d (want %d)\n", i, start[i], end[i],
+              quarter[i], quarterExpected, half[i], halfExpected);
+    }
+    CHECK(abs(quarter[i] - quarterExpected) <= 100);
+    CHECK(abs(half[i] - halfExpected) <= 100);
+  }
+
+  return checkExit();
+}
@@ -0,0 +1,145 @@
+// Pose seqlock under real threads. Several readers copy the published pose
+// while it is rewritten, and every copy has to be one whole frame:
+//  - flat out: a writer thread publishes frames back to back, each with a
+//    fixed pattern across the joints, so a torn copy shows up as a broken
+//    pattern or a frame older than one already seen;
+//  - at tick rate: the firmware's motion task publishes a /setAll sweep,
+//    which moves every joint alike, so each copy has 18 equal joints.
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+#define NUM_SERVOS 18
+extern uint16_t servoPositions[NUM_SERVOS];
+void posePublish();
+void poseSnapshot(uint16_t out[NUM_SERVOS]);
+
+#define READERS 4
+#define FLAT_OUT_FRAMES 2000000
+#define SWEEP_MS 3000
+
+struct ReaderStats {
+  uint64_t copies = 0;
+  uint64_t torn = 0;
+  uint64_t backwards = 0;
+  uint64_t changes = 0;
+};
+
+// Frame k carries k in joints 0 and 1 and k * 7 + i in every other joint i
+static void publishFrame(uint32_t k) {
+  servoPositions[0] = k;
+  servoPositions[1] = k >> 16;
+  for (int i = 2; i < NUM_SERVOS; i++) servoPositions[i] = k * 7 + i;
+  posePublish();
+}
+
+static void readPattern(std::atomic<bool> &done, ReaderStats &stats) {
+  uint32_t last = 0;
+  while (!done.load(std::memory_order_relaxed)) {
+    uint16_t pose[NUM_SERVOS];
+    poseSnapshot(pose);
+    stats.copies++;
+    uint32_t k = pose[0] | (uint32_t)pose[1] << 16;
+    for (int i = 2; i < NUM_SERVOS; i++) {
+      if (pose[i] != (uint16_t)(k * 7 + i)) {
+        stats.torn++;
+        break;
+      }
+    }
+    if (k < last) stats.backwards++;
+    if (k != last) stats.changes++;
+    last = k;
+  }
+}
+
+static void readEqual(std::atomic<bool> &done, ReaderStats &stats) {
+  uint16_t last = 0;
+  while (!done.load(std::memory_order_relaxed)) {
+    uint16_t pose[NUM_SERVOS];
+    poseSnapshot(pose);
+    stats.copies++;
+    for (int i = 1; i < NUM_SERVOS; i++) {
+      if (pose[i] != pose[0]) {
+        stats.torn++;
+        break;
+      }
+    }
+    if (pose[0] != last) stats.changes++;
+    last = pose[0];
+    std::this_thread::yield();
+  }
+}
+
+static ReaderStats total(const std::vector<ReaderStats> &stats) {
+  ReaderStats sum;
+  for (const ReaderStats &s : stats) {
+    sum.copies += s.copies;
+    sum.torn += s.torn;
+    sum.backwards += s.backwards;
+    sum.changes += s.changes;
+  }
+  return sum;
+}
+
+int main() {
+  // Flat out, before boot so this thread is the only writer
+  {
+    publishFrame(0);
+    std::atomic<bool> done{false};
+    std::vector<ReaderStats> stats(READERS);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) readers.emplace_back(readPattern, std::ref(done), std::ref(stats[r]));
+    std::thread writer([] {
+      for (uint32_t k = 1; k <= FLAT_OUT_FRAMES; k++) publishFrame(k);
+    });
+    writer.join();
+    done = true;
+    for (std::thread &reader : readers) reader.join();
+
+    ReaderStats sum = total(stats);
+    printf("seqlock: flat out: %u frames, %d readers, %llu copies, %llu frame changes seen, %llu torn, "
+           "%llu backwards\n",
+           FLAT_OUT_FRAMES, READERS, (unsigned long long)sum.copies, (unsigned long long)sum.changes,
+           (unsigned long long)sum.torn, (unsigned long long)sum.backwards);
+    CHECK_EQ(sum.torn, 0u);
+    CHECK_EQ(sum.backwards, 0u);
+    CHECK(sum.copies > 0);
+  }
+
+  // At tick rate from the motion task; no current budget, so no joint is
+  // held back while the others move
+  hostSetRealtime(true);
+  hostBoot();
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"budgetMa\":0}").code, 200);
+  {
+    std::atomic<bool> done{false};
+    std::vector<ReaderStats> stats(READERS);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) readers.emplace_back(readEqual, std::ref(done), std::ref(stats[r]));
+
+    auto started = std::chrono::steady_clock::now();
+    int angle = 0;
+    while (std::chrono::steady_clock::now() - started < std::chrono::milliseconds(SWEEP_MS)) {
+      angle = angle ? 0 : 180;
+      std::string body = "{\"angle\":" + std::to_string(angle) + "}";
+      CHECK_EQ(hostHttp("POST", "/setAll", body).code, 200);
+      hostRun(600);
+    }
+    done = true;
+    for (std::thread &reader : readers) reader.join();
+
+    ReaderStats sum = total(stats);
+    printf("seqlock: tick rate: %d readers, %llu copies, %llu frame changes seen, %llu torn\n", READERS,
+           (unsigned long long)sum.copies, (unsigned long long)sum.changes, (unsigned long long)sum.torn);
+    CHECK_EQ(sum.torn, 0u);
+    CHECK(sum.changes > 0);
+  }
+
+  return checkExit();
+}
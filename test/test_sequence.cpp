@@ -0,0 +1,69 @@
+// Sequence recorder: a recording stays in proportion to the motion it
+// captured, plays back to the end, and a full partition stops it cleanly.
+#include <sys/stat.h>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+static std::string fieldOf(const std::string &json, const std::string &key) {
+  size_t at = json.find("\"" + key + "\":");
+  if (at == std::string::npos) return "";
+  at += key.size() + 3;
+  if (json[at] == '"') return json.substr(at + 1, json.find('"', at + 1) - at - 1);
+  return json.substr(at, json.find_first_of(",}", at) - at);
+}
+
+static std::string sequenceStatus() { return hostHttp("GET", "/sequence").body; }
+
+int main() {
+  hostBoot();
+  hostRun(500);
+
+  // Record a move and the hold after it
+  CHECK_EQ(hostHttp("POST", "/sequence/record", "{\"name\":\"walk\"}").code, 200);
+  hostRun(50);
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":45}").code, 200);
+  hostRun(3000);
+  CHECK_EQ(hostHttp("POST", "/sequence/stop").code, 200);
+  hostRun(10);   // loop() writes the last frames and closes the file
+
+  std::string status = sequenceStatus();
+  CHECK_EQ(fieldOf(status, "state"), "idle");
+  uint32_t frames = std::stoul(fieldOf(status, "frames"));
+  uint32_t bytes = std::stoul(fieldOf(status, "bytes"));
+  CHECK(frames > 2);
+  CHECK(frames < 400);   // at most one frame per tick, plus the start pose
+  struct stat info;
+  CHECK_EQ(stat((hostFsRoot() + "/seq/walk.hxr").c_str(), &info), 0);
+  CHECK_EQ((uint32_t)info.st_size, bytes);
+
+  // Play it back to the end
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":120}").code, 200);
+  hostRun(3000);
+  CHECK_EQ(hostHttp("POST", "/sequence/play", "{\"name\":\"walk\"}").code, 200);
+  CHECK_EQ(fieldOf(sequenceStatus(), "state"), "playing");
+  hostRun(6000);
+  status = sequenceStatus();
+  CHECK_EQ(fieldOf(status, "state"), "idle");
+  CHECK_EQ(fieldOf(status, "result"), "done");
+  CHECK_CONTAINS(hostHttp("GET", "/getPositions").body, "\"positions\":[45,45,45");
+
+  // No room for the header and start pose
+  hostFsSetCapacity(16);
+  CHECK_EQ(hostHttp("POST", "/sequence/record", "{\"name\":\"tiny\"}").code, 200);
+  hostRun(10);
+  status = sequenceStatus();
+  CHECK_EQ(fieldOf(status, "state"), "idle");
+  CHECK_EQ(fieldOf(status, "result"), "error");
+
+  // Room for the start but not the move: recording stops as full
+  hostFsSetCapacity(120);
+  CHECK_EQ(hostHttp("POST", "/sequence/record", "{\"name\":\"short\"}").code, 200);
+  CHECK_EQ(hostHttp("POST", "/setAll", "{\"angle\":90}").code, 200);
+  hostRun(3000);
+  status = sequenceStatus();
+  CHECK_EQ(fieldOf(status, "state"), "idle");
+  CHECK_EQ(fieldOf(status, "result"), "full");
+
+  return checkExit();
+}
@@ -0,0 +1,141 @@
+// Slider streaming over the WebSocket: command-to-PWM latency. A load
+// generator drags one joint with cdeg frames at browser input rates and
+// faster. Each frame that moves the pulse width is timed from its arrival
+// to the first PCA9685 write that reaches (or passes) it; a frame inside
+// the same tick of pulse width as the one before has nothing to show. The same drag is then
+// sent as /setServo requests for comparison. Output limits are off, so
+// only the command path is measured.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+uint16_t angleToPWM(int servo, int cdeg);
+
+#define MOTION_TICK_US 10000
+#define SERVO 3            // board 0x40, channel 3
+#define DRAG_FRAMES 400
+#define WS_CMD_SERVO_CDEG 0x03
+
+struct Sent {
+  uint64_t us;
+  uint16_t ticks;
+};
+
+struct DragResult {
+  double p50Us, p99Us, maxUs;
+  double allocsPerFrame;
+  size_t timed;
+  size_t lost;   // frames never reflected on the PWM
+};
+
+static unsigned field(const std::string &json, const char *name) {
+  size_t at = json.find(std::string("\"") + name + "\":");
+  return at == std::string::npos ? 0 : strtoul(json.c_str() + at + strlen(name) + 3, nullptr, 10);
+}
+
+// Drag the joint upwards from 4500 cdeg by stepCdeg every periodUs, over
+// WebSocket or HTTP
+static DragResult drag(bool webSocket, uint32_t periodUs, int stepCdeg) {
+  // Start from rest at the bottom of the drag
+  char body[48];
+  snprintf(body, sizeof(body), "{\"servo\":%d,\"cdeg\":4500}", SERVO);
+  hostHttp("POST", "/setServo", body);
+  hostRun(200);
+  hostClearBusLog();
+
+  std::vector<Sent> sent;
+  std::vector<uint8_t> frame = {WS_CMD_SERVO_CDEG, SERVO, 0, 0};
+  uint64_t allocations = 0;
+  for (int i = 1; i <= DRAG_FRAMES; i++) {
+    int cdeg = 4500 + i * stepCdeg;
+    if (webSocket) {
+      frame[2] = cdeg & 0xFF;
+      frame[3] = cdeg >> 8;
+      uint64_t before = hostAllocations();
+      hostWebSocketBinary(frame);
+      allocations += hostAllocations() - before;
+    } else {
+      snprintf(body, sizeof(body), "{\"servo\":%d,\"cdeg\":%d}", SERVO, cdeg);
+      HostResponse response = hostHttp("POST", "/setServo", body);
+      CHECK_EQ(response.code, 200);
+      allocations += response.allocations;
+    }
+    sent.push_back({hostNowUs(), angleToPWM(SERVO, cdeg)});
+    uint64_t next = sent.back().us + periodUs;
+    while (hostNowUs() < next) hostRun(1);
+  }
+  hostRun(100);
+
+  // Writes to the joint's channel, in time order
+  std::vector<std::pair<uint64_t, uint16_t>> writes;
+  for (const HostChannelWrite &write : hostChannelWrites()) {
+    if (write.address == 0x40 && write.channel == SERVO) {
+      writes.push_back({write.timeUs, (uint16_t)((write.off - write.on) & 0x0FFF)});
+    }
+  }
+
+  DragResult result = {};
+  std::vector<double> latencies;
+  size_t w = 0;
+  uint16_t lastTicks = angleToPWM(SERVO, 4500);
+  for (const Sent &sentFrame : sent) {
+    if (sentFrame.ticks == lastTicks) continue;
+    lastTicks = sentFrame.ticks;
+    result.timed++;
+    while (w < writes.size() && (writes[w].first < sentFrame.us || writes[w].second < sentFrame.ticks)) w++;
+    if (w == writes.size()) {
+      result.lost++;
+      continue;
+    }
+    latencies.push_back(writes[w].first - sentFrame.us);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    result.p50Us = latencies[latencies.size() / 2];
+    result.p99Us = latencies[latencies.size() * 99 / 100];
+    result.maxUs = latencies.back();
+  }
+  result.allocsPerFrame = (double)allocations / DRAG_FRAMES;
+  return result;
+}
+
+static DragResult report(const char *path, uint32_t rateHz, const DragResult &r) {
+  printf("stream: %-9s %4u Hz: %3zu frames timed, latency p50 %5.0f us p99 %5.0f us max %5.0f us, "
+         "%5.1f allocs/frame, %zu lost\n",
+         path, rateHz, r.timed, r.p50Us, r.p99Us, r.maxUs, r.allocsPerFrame, r.lost);
+  return r;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"maxVel\":0,\"maxAccel\":0,\"budgetMa\":0}").code, 200);
+  // The stand-in's receive buffer grows once, on the first frame
+  hostWebSocketBinary({WS_CMD_SERVO_CDEG, SERVO, 4500 & 0xFF, 4500 >> 8});
+  hostRun(100);
+
+  // 60 Hz is a browser's input event rate; 1 kHz is several per tick
+  for (uint32_t rateHz : {60, 250, 1000}) {
+    DragResult ws = report("websocket", rateHz, drag(true, 1000000 / rateHz, 10));
+    // Every frame is on the PWM by the end of the next tick
+    CHECK_EQ(ws.lost, 0u);
+    CHECK(ws.maxUs <= MOTION_TICK_US + 1000);
+    CHECK(ws.allocsPerFrame == 0);
+  }
+  unsigned coalesced = field(hostHttp("GET", "/motion").body, "streamCoalesced");
+  printf("stream: %u updates coalesced into later ones\n", coalesced);
+  CHECK(coalesced > 0);
+
+  for (uint32_t rateHz : {60, 250}) {
+    DragResult http = report("http", rateHz, drag(false, 1000000 / rateHz, 10));
+    CHECK_EQ(http.lost, 0u);
+  }
+
+  return checkExit();
+}
@@ -0,0 +1,226 @@
+// UDP control stream: packets per second and packet-to-PWM latency. A load
+// generator sends pose packets that drag one joint at controller rates and
+// faster; each packet that moves the pulse width is timed from its arrival
+// to the first PCA9685 write that reaches (or passes) it, as for the
+// WebSocket in test_stream. A burst queued all at once measures how many
+// packets loop() gets through per second of host time. Packets that are
+// stale, duplicated, corrupted or malformed have to be counted in /motion
+// and leave the joints where they are.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "check.h"
+#include "hexapod_host.h"
+
+// Sketch internals
+uint16_t angleToPWM(int servo, int cdeg);
+
+#define MOTION_TICK_US 10000
+#define NUM_SERVOS 18
+#define SERVO 3            // board 0x40, channel 3
+#define DRAG_PACKETS 400
+#define BURST_PACKETS 20000
+
+// Wire format, as in the sketch
+#define UDP_VERSION 1
+#define UDP_TYPE_POSE 0x01
+#define UDP_TYPE_GAIT 0x02
+
+struct Sent {
+  uint64_t us;
+  uint16_t ticks;
+};
+
+struct DragResult {
+  double p50Us, p99Us, maxUs;
+  size_t timed;
+  size_t lost;   // packets never reflected on the PWM
+};
+
+static uint32_t seq = 0;
+static std::vector<int> pose;   // cdeg of every joint in the packets
+
+static unsigned field(const std::string &json, const char *name) {
+  size_t at = json.find(std::string("\"") + name + "\":");
+  return at == std::string::npos ? 0 : strtoul(json.c_str() + at + strlen(name) + 3, nullptr, 10);
+}
+
+static unsigned motion(const char *name) { return field(hostHttp("GET", "/motion").body, name); }
+
+static std::vector<int> positionsCdeg() {
+  std::string body = hostHttp("GET", "/getPositions").body;
+  std::vector<int> out;
+  size_t at = body.find('[', body.find("\"positionsCdeg\""));
+  while (at != std::string::npos && body[at] != ']') {
+    out.push_back(atoi(body.c_str() + at + 1));
+    at = body.find_first_of(",]", at + 1);
+  }
+  return out;
+}
+
+// CRC-16/CCITT-FALSE, written from the protocol rather than the sketch
+static uint16_t crc(const std::vector<uint8_t> &data) {
+  uint16_t value = 0xFFFF;
+  for (uint8_t byte : data) {
+    value ^= byte << 8;
+    for (int bit = 0; bit < 8; bit++) value = value & 0x8000 ? (value << 1) ^ 0x1021 : value << 1;
+  }
+  return value;
+}
+
+static void put16(std::vector<uint8_t> &packet, uint16_t value) {
+  packet.push_back(value & 0xFF);
+  packet.push_back(value >> 8);
+}
+
+static std::vector<uint8_t> packet(uint8_t type, uint32_t packetSeq, const std::vector<uint16_t> &payload) {
+  std::vector<uint8_t> out = {'H', 'X', UDP_VERSION, type};
+  for (int i = 0; i < 4; i++) out.push_back(packetSeq >> (8 * i));
+  for (uint16_t word : payload) put16(out, word);
+  put16(out, crc(out));
+  return out;
+}
+
+static std::vector<uint8_t> posePacket(uint32_t packetSeq) {
+  return packet(UDP_TYPE_POSE, packetSeq, std::vector<uint16_t>(pose.begin(), pose.end()));
+}
+
+// Drag the joint upwards from 4500 cdeg by stepCdeg every periodUs
+static DragResult drag(uint32_t periodUs, int stepCdeg) {
+  pose[SERVO] = 4500;
+  hostUdpPacket(posePacket(++seq));
+  hostRun(200);
+  hostClearBusLog();
+
+  std::vector<Sent> sent;
+  for (int i = 1; i <= DRAG_PACKETS; i++) {
+    pose[SERVO] = 4500 + i * stepCdeg;
+    hostUdpPacket(posePacket(++seq));
+    // The datagram is read on the next pass of loop()
+    sent.push_back({hostNowUs(), angleToPWM(SERVO, pose[SERVO])});
+    uint64_t next = sent.back().us + periodUs;
+    while (hostNowUs() < next) hostRun(1);
+  }
+  hostRun(100);
+
+  std::vector<std::pair<uint64_t, uint16_t>> writes;
+  for (const HostChannelWrite &write : hostChannelWrites()) {
+    if (write.address == 0x40 && write.channel == SERVO) {
+      writes.push_back({write.timeUs, (uint16_t)((write.off - write.on) & 0x0FFF)});
+    }
+  }
+
+  DragResult result = {};
+  std::vector<double> latencies;
+  size_t w = 0;
+  uint16_t lastTicks = angleToPWM(SERVO, 4500);
+  for (const Sent &sentPacket : sent) {
+    if (sentPacket.ticks == lastTicks) continue;
+    lastTicks = sentPacket.ticks;
+    result.timed++;
+    while (w < writes.size() && (writes[w].first < sentPacket.us || writes[w].second < sentPacket.ticks)) w++;
+    if (w == writes.size()) {
+      result.lost++;
+      continue;
+    }
+    latencies.push_back(writes[w].first - sentPacket.us);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  if (!latencies.empty()) {
+    result.p50Us = latencies[latencies.size() / 2];
+    result.p99Us = latencies[latencies.size() * 99 / 100];
+    result.maxUs = latencies.back();
+  }
+  printf("udp: %4u Hz: %3zu packets timed, latency p50 %5.0f us p99 %5.0f us max %5.0f us, %zu lost\n",
+         1000000 / periodUs, result.timed, result.p50Us, result.p99Us, result.maxUs, result.lost);
+  return result;
+}
+
+int main() {
+  hostBoot();
+  hostRun(500);
+  CHECK_EQ(hostHttp("POST", "/limits", "{\"maxVel\":0,\"maxAccel\":0,\"budgetMa\":0}").code, 200);
+  pose = positionsCdeg();
+  CHECK_EQ(pose.size(), (size_t)NUM_SERVOS);
+  if (pose.size() != NUM_SERVOS) return checkExit();
+
+  // 60 Hz is a gamepad's report rate; 1 kHz is several packets per tick
+  for (uint32_t rateHz : {60, 250, 1000}) {
+    DragResult r = drag(1000000 / rateHz, 10);
+    CHECK_EQ(r.lost, 0u);
+    CHECK(r.timed > 0);
+    // Read on the next loop pass, on the PWM by the end of the next tick
+    CHECK(r.maxUs <= MOTION_TICK_US + 1000);
+  }
+
+  // Throughput: a burst queued at once is drained in one pass of loop()
+  unsigned accepted = motion("udpAccepted");
+  std::vector<std::vector<uint8_t>> burst;
+  for (int i = 0; i < BURST_PACKETS; i++) {
+    pose[SERVO] = 4500 + i % 4000;
+    burst.push_back(posePacket(++seq));
+  }
+  uint64_t idleAllocations = hostAllocations();
+  hostRun(1);
+  idleAllocations = hostAllocations() - idleAllocations;
+  for (const std::vector<uint8_t> &p : burst) hostUdpPacket(p);
+  uint64_t allocations = hostAllocations();
+  auto started = std::chrono::steady_clock::now();
+  hostRun(1);
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  allocations = hostAllocations() - allocations - idleAllocations;
+  unsigned burstAccepted = motion("udpAccepted") - accepted;
+  printf("udp: burst of %d packets in %.1f ms, %.0f packets/s, %.2f allocs/packet\n", BURST_PACKETS,
+         seconds * 1e3, BURST_PACKETS / seconds, (double)allocations / BURST_PACKETS);
+  CHECK_EQ(burstAccepted, (unsigned)BURST_PACKETS);
+  CHECK_EQ(allocations, 0u);
+  hostRun(100);
+
+  // Rejects: none of these may move a joint
+  pose[SERVO] = 9000;
+  hostUdpPacket(posePacket(++seq));
+  hostRun(100);
+  std::vector<int> held = positionsCdeg();
+  CHECK_EQ(held[SERVO], 9000);
+  unsigned stale = motion("udpStale"), crcErrors = motion("udpCrcErrors"), malformed = motion("udpMalformed");
+  accepted = motion("udpAccepted");
+
+  pose[SERVO] = 6000;
+  hostUdpPacket(posePacket(seq));          // duplicate
+  hostUdpPacket(posePacket(seq - 5));      // reordered
+  std::vector<uint8_t> corrupt = posePacket(seq + 1);
+  corrupt[10] ^= 0x40;
+  hostUdpPacket(corrupt);                  // bit flip in the payload
+  std::vector<uint8_t> shortPose = posePacket(seq + 1);
+  shortPose.erase(shortPose.begin() + 8, shortPose.begin() + 10);
+  hostUdpPacket(shortPose);                // wrong length for its type
+  std::vector<uint8_t> version = posePacket(seq + 1);
+  version[2] = UDP_VERSION + 1;
+  hostUdpPacket(version);                  // unknown version
+  pose[SERVO] = 18001;
+  hostUdpPacket(posePacket(seq + 1));      // joint past 180 degrees
+  hostUdpPacket(packet(UDP_TYPE_GAIT, seq + 2, {0, 0, 0, 0x00EE}));   // no such gait
+  hostUdpPacket(std::vector<uint8_t>(100, 'H'));   // larger than any packet
+  hostRun(100);
+
+  printf("udp: rejects: %u stale, %u bad CRC, %u malformed\n", motion("udpStale") - stale,
+         motion("udpCrcErrors") - crcErrors, motion("udpMalformed") - malformed);
+  CHECK_EQ(motion("udpStale") - stale, 2u);
+  CHECK_EQ(motion("udpCrcErrors") - crcErrors, 1u);
+  CHECK_EQ(motion("udpMalformed") - malformed, 5u);
+  CHECK_EQ(motion("udpAccepted"), accepted);
+  CHECK(positionsCdeg() == held);
+
+  // A new sender starts its own sequence, even from below the last one
+  pose[SERVO] = 6000;
+  hostUdpPacket(posePacket(1), 0x7F000001, 40001);
+  hostRun(100);
+  CHECK_EQ(motion("udpAccepted"), accepted + 1);
+  CHECK_EQ(positionsCdeg()[SERVO], 6000);
+
+  return checkExit();
+}